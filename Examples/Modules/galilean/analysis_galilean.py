@@ -0,0 +1,35 @@
+#! /usr/bin/env python
+
+# This is a script that analyses the simulation results from the script
+# `inputs2d`: a relativistic plasma drifts through the grid, with the
+# Galilean PSATD solver (the grid moves with the plasma), and without the
+# NCI corrector or filtering. The numerical Cherenkov instability must not
+# develop: the energy of the fields must stay small after 1000 steps.
+# The script then reruns the same simulation with the standard PSATD solver,
+# and checks that the instability grows in this case.
+import sys
+sys.path.insert(0, '.')
+import yt
+yt.funcs.mylog.setLevel(0)
+import numpy as np
+import scipy.constants as scc
+from reference_run import run_reference
+
+def get_energy( fn ):
+    ds = yt.load( fn )
+    ad = ds.all_data()
+    ex = np.reshape(ad['boxlib', 'Ex'].v,(128,128))
+    ez = np.reshape(ad['boxlib', 'Ez'].v,(128,128))
+    by = np.reshape(ad['boxlib', 'By'].v,(128,128))
+    return( np.sum(ex**2 + ez**2 + scc.c**2*by**2)*1.e-12 )
+
+fn = sys.argv[1]
+energy = get_energy( fn )
+print( 'Energy with the Galilean solver: %.3e' %energy )
+# Bound of the NCI corrector test (see nci_corrector/ncicorr_analysis.py)
+assert( energy < 7. )
+
+fn_ref = run_reference( fn, 'inputs2d', ['psatd.v_galilean=0.', '0.', '0.'] )
+energy_ref = get_energy( fn_ref )
+print( 'Energy with the standard solver: %.3e' %energy_ref )
+assert( energy_ref > 100.*energy )
@@ -0,0 +1,47 @@
+#! /usr/bin/env python
+
+# This is a script that analyses the simulation results from the script
+# `inputs2d`, run with a moving window that is slower than the Galilean grid
+# (test galilean_nci_moving_window): the grid moves continuously with
+# `psatd.v_galilean`, and is shifted back by whole cells whenever it is more
+# than one cell ahead of the window. The script checks that:
+# - the domain has been shifted by a whole number of cells with respect to
+#   the Galilean grid, and is less than a cell away from the window
+# - the numerical Cherenkov instability does not develop (as in
+#   analysis_galilean.py), despite the shifts of the fields
+import sys
+import yt
+yt.funcs.mylog.setLevel(0)
+import numpy as np
+import scipy.constants as scc
+
+# Parameters (these parameters must match the parameters of the test,
+# in `inputs2d` and `WarpX-tests.ini`)
+zmin = -20.e-6
+dz = 40.e-6/128
+v_galilean = 0.9999995*scc.c
+v_window = 0.99*scc.c
+
+fn = sys.argv[1]
+ds = yt.load( fn )
+t = ds.current_time.to_ndarray().mean()
+zlo = ds.domain_left_edge[1].v
+
+# Position of the domain
+n_shift = ( zlo - (zmin + v_galilean*t) )/dz
+print( 'Shift of the window: %.6f cells' %n_shift )
+assert( abs( n_shift - round(n_shift) ) < 1.e-3 )
+assert( round(n_shift) <= -1 )
+# The grid is ahead of the window (by less than a cell)
+dz_window = zlo - (zmin + v_window*t)
+assert( -1.e-3*dz <= dz_window < (1. + 1.e-3)*dz )
+
+# Energy of the fields
+ad = ds.all_data()
+ex = np.reshape(ad['boxlib', 'Ex'].v,(128,128))
+ez = np.reshape(ad['boxlib', 'Ez'].v,(128,128))
+by = np.reshape(ad['boxlib', 'By'].v,(128,128))
+energy = np.sum(ex**2 + ez**2 + scc.c**2*by**2)*1.e-12
+print( 'Energy with the Galilean solver and the moving window: %.3e' %energy )
+# Bound of the NCI corrector test (see nci_corrector/ncicorr_analysis.py)
+assert( energy < 7. )
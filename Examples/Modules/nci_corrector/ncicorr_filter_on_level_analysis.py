@@ -0,0 +1,18 @@
+#! /usr/bin/env python
+
+# This is a script that analyses the simulation results from the script
+# `inputs2d`, run with `particles.nci_corr_filter_on_level=1` (test
+# nci_corrector_filter_on_level). It reruns the same simulation with the
+# fields filtered tile by tile, and checks that both runs give the same
+# fields, up to round-off errors.
+import sys
+sys.path.insert(0, '.')
+from reference_run import run_reference, compare_fields
+
+fn = sys.argv[1]
+# Same parameters as the test (see `WarpX-tests.ini`), with the per-tile filter
+params = ['warpx.do_dynamic_scheduling=0', 'particles.nci_corr_filter_on_level=0',
+          'max_step=200', 'amr.plot_int=200']
+
+fn_ref = run_reference( fn, 'inputs2d', params )
+compare_fields( fn, fn_ref )
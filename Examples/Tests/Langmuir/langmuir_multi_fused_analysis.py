@@ -0,0 +1,25 @@
+#! /usr/bin/env python
+
+# This is a script that analyses the simulation results from the script
+# `inputs.multi.rt`, run with `algo.fused_particle_loop=1` (tests
+# Langmuir_multi_fused and Langmuir_multi_fused_esirkepov). It reruns the
+# same simulation with the separate gather, push and deposition, and checks
+# that both runs give the same fields, up to round-off errors.
+import os
+import sys
+sys.path.insert(0, '.')
+from reference_run import run_reference, compare_fields
+
+fn = sys.argv[1]
+# The Esirkepov variant is recognized from the name of the plotfile
+# (`<test name>_plt<step>`), and the reference run uses the same
+# parameters as the test (see `WarpX-tests.ini`)
+params = ['warpx.do_dynamic_scheduling=0', 'algo.fused_particle_loop=0']
+if 'esirkepov' in os.path.basename( fn.rstrip('/') ):
+    params += ['algo.current_deposition=0', 'interpolation.nox=3',
+               'interpolation.noy=3', 'interpolation.noz=3']
+
+fn_ref = run_reference( fn, 'inputs.multi.rt', params )
+# The fused kernels do not sum the contributions of the particles in the
+# same order as the separate kernels
+compare_fields( fn, fn_ref, rtol=1.e-7 )
@@ -0,0 +1,17 @@
+#! /usr/bin/env python
+
+# This is a script that analyses the simulation results from the script
+# `inputs.multi.rt`, run with `warpx.overlap_field_comm=1` (test
+# Langmuir_multi_overlap_comm). It reruns the same simulation with the
+# blocking guard cell exchanges, and checks that both runs give the same
+# fields, up to round-off errors.
+import sys
+sys.path.insert(0, '.')
+from reference_run import run_reference, compare_fields
+
+fn = sys.argv[1]
+# Same parameters as the test (see `WarpX-tests.ini`), without the overlap
+params = ['warpx.do_dynamic_scheduling=0', 'warpx.overlap_field_comm=0']
+
+fn_ref = run_reference( fn, 'inputs.multi.rt', params )
+compare_fields( fn, fn_ref )
@@ -0,0 +1,18 @@
+#! /usr/bin/env python
+
+# This is a script that analyses the simulation results from the script
+# `inputs.multi.rt`, run with `particles.evolve_species_by_tile=1` (test
+# Langmuir_multi_species_by_tile). It reruns the same simulation with one
+# loop over the tiles for each species, and checks that both runs give the
+# same fields, up to round-off errors.
+import sys
+sys.path.insert(0, '.')
+from reference_run import run_reference, compare_fields
+
+fn = sys.argv[1]
+# Same parameters as the test (see `WarpX-tests.ini`), species by species
+params = ['warpx.do_dynamic_scheduling=0', 'particles.evolve_species_by_tile=0']
+
+fn_ref = run_reference( fn, 'inputs.multi.rt', params )
+# The currents of the two species are added to the grid in a different order
+compare_fields( fn, fn_ref, rtol=1.e-7 )
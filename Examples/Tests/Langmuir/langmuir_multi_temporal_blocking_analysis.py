@@ -0,0 +1,22 @@
+#! /usr/bin/env python
+
+# This is a script that analyses the simulation results from the script
+# `inputs.multi.rt`, run with `algo.fdtd_temporal_blocking=1` (tests
+# Langmuir_multi_temporal_blocking and Langmuir_multi_nodal_temporal_blocking).
+# It reruns the same simulation with the standard B/E/B field push, and
+# checks that both runs give the same fields, up to round-off errors.
+import os
+import sys
+sys.path.insert(0, '.')
+from reference_run import run_reference, compare_fields
+
+fn = sys.argv[1]
+# The nodal variant is recognized from the name of the plotfile
+# (`<test name>_plt<step>`), and the reference run uses the same
+# parameters as the test (see `WarpX-tests.ini`)
+params = ['warpx.do_dynamic_scheduling=0', 'algo.fdtd_temporal_blocking=0']
+if 'nodal' in os.path.basename( fn.rstrip('/') ):
+    params.append('warpx.do_nodal=1')
+
+fn_ref = run_reference( fn, 'inputs.multi.rt', params )
+compare_fields( fn, fn_ref )
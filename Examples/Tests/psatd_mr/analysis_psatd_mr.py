@@ -0,0 +1,55 @@
+#! /usr/bin/env python
+
+# This is a script that analyses the simulation results from the script
+# `inputs.2d`: a laser pulse crosses a refined patch, with the PSATD solver.
+# At the end of the simulation, the pulse straddles the upper end of the
+# patch. The fields of the patch (level 1), averaged over the fine cells of
+# each coarse cell, must match the fields of level 0 under the patch: the
+# guard cells of the FFT boxes of the patch hold the fields of level 0, so
+# that the part of the pulse that leaves the patch does not come back into it
+# (e.g. through the periodicity of the FFT boxes).
+#
+# With load balancing (test psatd_mr_load_balance, recognized from the name of
+# the plotfile), the script also reruns the simulation without it, and checks
+# that both runs give the same fields.
+import os
+import sys
+sys.path.insert(0, '.')
+import yt
+yt.funcs.mylog.setLevel(50)
+import numpy as np
+from reference_run import run_reference, compare_fields
+
+fn = sys.argv[1]
+ds = yt.load( fn )
+
+# Extent of the refined patch
+grids = [ g for g in ds.index.grids if g.Level == 1 ]
+patch_lo = np.min( [ g.LeftEdge.v for g in grids ], axis=0 )
+patch_hi = np.max( [ g.RightEdge.v for g in grids ], axis=0 )
+dx0 = ds.domain_width.v / ds.domain_dimensions
+ncells0 = np.round( (patch_hi - patch_lo)/dx0 ).astype(int)
+ncells0[2] = 1
+
+fine = ds.covering_grid( level=1, left_edge=patch_lo, dims=2*ncells0 )
+crse = ds.covering_grid( level=0, left_edge=patch_lo, dims=ncells0 )
+
+E_max = abs( crse['boxlib', 'Ex'].v ).max()
+for field in ['Ex', 'By']:
+    f = fine['boxlib', field].v.squeeze()
+    # Average over the 2x2 fine cells of each coarse cell
+    f = 0.25*( f[0::2,0::2] + f[1::2,0::2] + f[0::2,1::2] + f[1::2,1::2] )
+    c = crse['boxlib', field].v.squeeze()
+    scale = abs( c ).max()
+    error = abs( f - c ).max()
+    print( '%s: max. difference between the levels %.3e (max. value %.3e)'
+           %(field, error, scale) )
+    assert error < 0.05 * scale
+
+# The pulse is in the patch
+assert E_max > 0.1 * 1.e12
+
+if 'load_balance' in os.path.basename( fn.rstrip('/') ):
+    fn_ref = run_reference( fn, 'inputs.2d', ['warpx.load_balance_int=-1'] )
+    for level in [0, 1]:
+        compare_fields( fn, fn_ref, level=level )
@@ -0,0 +1,23 @@
+#! /usr/bin/env python
+
+# This is a script that analyses the simulation results from the script
+# `inputs.2d`, run with subcycling and a refinement ratio of 4 (test
+# subcyclingMR_ratio4). It reruns the same simulation without subcycling,
+# i.e. with the time step of the fine level on both levels, and checks that
+# the fields of the coarse level agree within a few percent. (With a ratio
+# of 4, B is interpolated in time for the auxiliary fields of the
+# intermediate fine steps, which this test covers.)
+import sys
+sys.path.insert(0, '.')
+from reference_run import run_reference, compare_fields
+
+fn = sys.argv[1]
+# Same parameters as the test (see `WarpX-tests.ini`), without subcycling:
+# 4 times more steps to reach the same time
+params = ['amr.ref_ratio=4', 'warpx.do_subcycling=0',
+          'warpx.do_moving_window=0', 'warpx.do_plasma_injection=0',
+          'max_step=400', 'amr.plot_int=400',
+          'warpx.serialize_ics=1', 'warpx.do_dynamic_scheduling=0']
+
+fn_ref = run_reference( fn, 'inputs.2d', params, step=400 )
+compare_fields( fn, fn_ref, fields=['Ex','Ez','By'], rtol=5.e-2 )
@@ -0,0 +1,51 @@
+#! /usr/bin/env python
+
+# This is a helper for the analysis scripts of the regression tests that check
+# an alternative code path (e.g. a reordered field push) against the standard
+# one. The regression test suite copies the executable and the inputs file of
+# the test into its run directory: `run_reference` reruns them there, with the
+# options of the standard code path, and `compare_fields` compares the
+# plotfiles of both runs at the same step.
+# (Add this file to the `auxFiles` of the test, so that it is copied as well.)
+import glob
+import re
+import subprocess
+import yt
+yt.funcs.mylog.setLevel(50)
+import numpy as np
+
+def run_reference( fn, inputs, runtime_params, plot_file='reference_plt',
+                   step=None ):
+    """
+    Rerun the executable of the test with the inputs file `inputs` and the
+    list of parameters `runtime_params` (given last on the command line, so
+    that they override those of the inputs file), and return the name of the
+    plotfile of this reference run at the same step as the plotfile `fn`
+    (or at the step `step`, when the reference run uses another time step).
+    """
+    executable = glob.glob('*.ex')[0]
+    subprocess.check_call( ['./' + executable, inputs] + runtime_params
+                           + ['amr.plot_file=' + plot_file] )
+    if step is None:
+        return( plot_file + re.search(r'(\d+)$', fn.rstrip('/')).group(1) )
+    return( plot_file + '%05d' %step )
+
+def get_fields( fn, fields, level=0 ):
+    ds = yt.load( fn )
+    data = ds.covering_grid(level=level, left_edge=ds.domain_left_edge,
+                    dims=ds.domain_dimensions * ds.refine_by**level)
+    return( { f: data['boxlib', f].v.squeeze() for f in fields } )
+
+def compare_fields( fn, fn_ref, fields=['Ex','Ey','Ez','Bx','By','Bz','jx','jy','jz'],
+                    rtol=1.e-9, level=0 ):
+    """
+    Check that the fields of the plotfile `fn` match those of `fn_ref`,
+    within `rtol` times the maximum of each field in `fn_ref`.
+    """
+    data = get_fields( fn, fields, level )
+    data_ref = get_fields( fn_ref, fields, level )
+    for f in fields:
+        scale = abs( data_ref[f] ).max()
+        error = abs( data[f] - data_ref[f] ).max()
+        print( '%s: max. difference %.3e (max. value %.3e)' %(f, error, scale) )
+        assert error <= rtol * scale
@@ -65,6 +65,25 @@ namespace
         std::fill(sigma.begin()+(olo-slo), sigma.begin()+(ohi+2-slo), 0.0);
         std::fill(sigma_star.begin()+(olo-sslo), sigma_star.begin()+(ohi+1-sslo), 0.0);
     }
+
+    static void RedistributeMF (std::unique_ptr<MultiFab>& mf, const DistributionMapping& dm)
+    {
+        if (!mf) return;
+        const IntVect& ng = mf->nGrowVect();
+        auto pmf = std::unique_ptr<MultiFab>(new MultiFab(mf->boxArray(), dm, mf->nComp(), ng));
+        pmf->Redistribute(*mf, 0, 0, mf->nComp(), ng);
+        mf = std::move(pmf);
+    }
+
+    static DistributionMapping FollowGrids (const Vector<int>& grid_index,
+                                            const DistributionMapping& grid_dm)
+    {
+        Vector<int> pmap(grid_index.size());
+        for (int i = 0, N = grid_index.size(); i < N; ++i) {
+            pmap[i] = grid_dm[grid_index[i]];
+        }
+        return DistributionMapping(pmap);
+    }
 }
 
 SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx, int ncell, int delta)
@@ -331,7 +350,10 @@ PML::PML (const BoxArray& grid_ba, const DistributionMapping& grid_dm,
           const Geometry* geom, const Geometry* cgeom,
           int ncell, int delta, int ref_ratio, int do_dive_cleaning, int do_moving_window)
     : m_geom(geom),
-      m_cgeom(cgeom)
+      m_cgeom(cgeom),
+      m_grid_ba(grid_ba),
+      m_ncell(ncell),
+      m_delta(delta)
 {
     const BoxArray& ba = MakeBoxArray(*geom, grid_ba, ncell);
     if (ba.size() == 0) {
@@ -341,6 +363,9 @@ PML::PML (const BoxArray& grid_ba, const DistributionMapping& grid_dm,
         m_ok = true;
     }
 
+    m_grid_index_fp = GridIndex(ba, grid_ba, ncell);
+    m_costs_fp.resize(ba.size(), 0.);
+
     DistributionMapping dm{ba};
 
     int nge = 2;
@@ -368,7 +393,7 @@ PML::PML (const BoxArray& grid_ba, const DistributionMapping& grid_dm,
         pml_F_fp->setVal(0.0);
     }
 
-    sigba_fp.reset(new MultiSigmaBox(ba, dm, grid_ba, geom->CellSize(), ncell, delta));
+    sigba_fp.reset(new MultiSigmaBox(ba, dm, m_grid_ba, geom->CellSize(), ncell, delta));
 
     if (cgeom)
     {
@@ -376,9 +401,12 @@ PML::PML (const BoxArray& grid_ba, const DistributionMapping& grid_dm,
         nge = 1;
         ngb = 1;
 
-        BoxArray grid_cba = grid_ba;
-        grid_cba.coarsen(ref_ratio);
-        const BoxArray& cba = MakeBoxArray(*cgeom, grid_cba, ncell);
+        m_grid_cba = grid_ba;
+        m_grid_cba.coarsen(ref_ratio);
+        const BoxArray& cba = MakeBoxArray(*cgeom, m_grid_cba, ncell);
+
+        m_grid_index_cp = GridIndex(cba, m_grid_cba, ncell);
+        m_costs_cp.resize(cba.size(), 0.);
 
         DistributionMapping cdm{cba};
 
@@ -402,7 +430,7 @@ PML::PML (const BoxArray& grid_ba, const DistributionMapping& grid_dm,
             pml_F_cp->setVal(0.0);
         }
 
-        sigba_cp.reset(new MultiSigmaBox(cba, cdm, grid_cba, cgeom->CellSize(), ncell, delta));
+        sigba_cp.reset(new MultiSigmaBox(cba, cdm, m_grid_cba, cgeom->CellSize(), ncell, delta));
     }
 
 }
@@ -467,9 +495,31 @@ PML::MakeBoxArray (const amrex::Geometry& geom, const amrex::BoxArray& grid_ba,
     return ba;
 }
 
+Vector<int>
+PML::GridIndex (const BoxArray& ba, const BoxArray& grid_ba, int ncell)
+{
+    // Each PML box touches the grid box it was made from, and is within
+    // ncell cells of it
+    Vector<int> index(ba.size(), 0);
+    for (int i = 0, N = ba.size(); i < N; ++i)
+    {
+        const auto& isects = grid_ba.intersections(amrex::grow(ba[i],1));
+        if (!isects.empty()) index[i] = isects[0].first;
+        for (const auto& is : isects)
+        {
+            if (amrex::grow(grid_ba[is.first],ncell).contains(ba[i])) {
+                index[i] = is.first;
+                break;
+            }
+        }
+    }
+    return index;
+}
+
 void
 PML::ComputePMLFactors (amrex::Real dt)
 {
+    m_dt = dt;
     if (sigba_fp) {
         sigba_fp->ComputePMLFactorsB(m_geom->CellSize(), dt);
         sigba_fp->ComputePMLFactorsE(m_geom->CellSize(), dt);
@@ -753,3 +803,82 @@ PML::Restart (const std::string& dir)
         VisMF::Read(*pml_B_cp[2], dir+"_Bz_cp");
     }
 }
+
+void
+PML::RemakeDistributionMap (const DistributionMapping& grid_dm)
+{
+    if (!m_ok) return;
+
+    const DistributionMapping& dm = FollowGrids(m_grid_index_fp, grid_dm);
+    for (int idim = 0; idim < 3; ++idim) {
+        RedistributeMF(pml_E_fp[idim], dm);
+        RedistributeMF(pml_B_fp[idim], dm);
+    }
+    RedistributeMF(pml_F_fp, dm);
+    sigba_fp.reset(new MultiSigmaBox(sigba_fp->boxArray(), dm, m_grid_ba,
+                                     m_geom->CellSize(), m_ncell, m_delta));
+
+    if (m_cgeom)
+    {
+        const DistributionMapping& cdm = FollowGrids(m_grid_index_cp, grid_dm);
+        for (int idim = 0; idim < 3; ++idim) {
+            RedistributeMF(pml_E_cp[idim], cdm);
+            RedistributeMF(pml_B_cp[idim], cdm);
+        }
+        RedistributeMF(pml_F_cp, cdm);
+        sigba_cp.reset(new MultiSigmaBox(sigba_cp->boxArray(), cdm, m_grid_cba,
+                                         m_cgeom->CellSize(), m_ncell, m_delta));
+    }
+
+    if (m_dt > 0.) ComputePMLFactors(m_dt);
+}
+
+void
+PML::AddCost (PatchType patch_type, int box_index, Real wt)
+{
+    Real& cost = (patch_type == PatchType::fine) ? m_costs_fp[box_index] : m_costs_cp[box_index];
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    cost += wt;
+}
+
+void
+PML::ScaleCosts (Real fac)
+{
+    for (auto& c : m_costs_fp) c *= fac;
+    for (auto& c : m_costs_cp) c *= fac;
+}
+
+Vector<Real>
+PML::CostsPerGrid () const
+{
+    Vector<Real> r(m_grid_ba.size(), 0.);
+    for (int i = 0, N = m_costs_fp.size(); i < N; ++i) {
+        r[m_grid_index_fp[i]] += m_costs_fp[i];
+    }
+    for (int i = 0, N = m_costs_cp.size(); i < N; ++i) {
+        r[m_grid_index_cp[i]] += m_costs_cp[i];
+    }
+    ParallelDescriptor::ReduceRealSum(r.data(), r.size());
+    return r;
+}
+
+Vector<Real>
+PML::NumCellsPerGrid () const
+{
+    Vector<Real> r(m_grid_ba.size(), 0.);
+    if (sigba_fp) {
+        const BoxArray& ba = sigba_fp->boxArray();
+        for (int i = 0, N = ba.size(); i < N; ++i) {
+            r[m_grid_index_fp[i]] += ba[i].d_numPts();
+        }
+    }
+    if (sigba_cp) {
+        const BoxArray& cba = sigba_cp->boxArray();
+        for (int i = 0, N = cba.size(); i < N; ++i) {
+            r[m_grid_index_cp[i]] += cba[i].d_numPts();
+        }
+    }
+    return r;
+}
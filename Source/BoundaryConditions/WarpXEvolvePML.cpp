@@ -38,6 +38,10 @@ WarpX::DampPML (int lev, PatchType patch_type)
 
     if (pml[lev]->ok())
     {
+        // The damped PML fields are copied to the guard cells of E and B
+        // by the next FillBoundary
+        MarkFieldsModified(lev);
+
         const auto& pml_E = (patch_type == PatchType::fine) ? pml[lev]->GetE_fp() : pml[lev]->GetE_cp();
         const auto& pml_B = (patch_type == PatchType::fine) ? pml[lev]->GetB_fp() : pml[lev]->GetB_cp();
         const auto& pml_F = (patch_type == PatchType::fine) ? pml[lev]->GetF_fp() : pml[lev]->GetF_cp();
@@ -49,6 +53,8 @@ WarpX::DampPML (int lev, PatchType patch_type)
 #endif
         for ( MFIter mfi(*pml_E[0], TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
+            Real wt = amrex::second();
+
             const Box& tex  = mfi.tilebox(Ex_nodal_flag);
             const Box& tey  = mfi.tilebox(Ey_nodal_flag);
             const Box& tez  = mfi.tilebox(Ez_nodal_flag);
@@ -76,6 +82,10 @@ WarpX::DampPML (int lev, PatchType patch_type)
 			        BL_TO_FORTRAN_3D((*pml_F)[mfi]),
 			        WRPX_PML_TO_FORTRAN(sigba[mfi]));
             }
+
+            if (costs[lev]) {
+                pml[lev]->AddCost(patch_type, mfi.index(), amrex::second() - wt);
+            }
         }
     }
 }
@@ -619,6 +619,7 @@ WarpX::WritePlotFile () const
     particle_varnames.push_back("momentum_y");
     particle_varnames.push_back("momentum_z");
 
+#ifndef WARPX_LEAN_PARTICLES
     particle_varnames.push_back("Ex");
     particle_varnames.push_back("Ey");
     particle_varnames.push_back("Ez");
@@ -626,6 +627,7 @@ WarpX::WritePlotFile () const
     particle_varnames.push_back("Bx");
     particle_varnames.push_back("By");
     particle_varnames.push_back("Bz");
+#endif
 
 #ifdef WARPX_RZ
     particle_varnames.push_back("theta");
@@ -642,6 +644,15 @@ WarpX::WritePlotFile () const
         particle_varnames.push_back("uzold");
     }
 
+#ifdef WARPX_LEAN_PARTICLES
+    if (WarpX::plot_particle_fields)
+    {
+        for (const auto& name : ParticleStringNames::field_names) {
+            particle_varnames.push_back(name);
+        }
+    }
+#endif
+
     mypc->WritePlotFile(plotfilename, particle_plot_flags, particle_varnames);
 
     WriteJobInfo(plotfilename);
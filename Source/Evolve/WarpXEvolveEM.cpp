@@ -5,6 +5,7 @@
 #include <WarpX.H>
 #include <WarpXConst.H>
 #include <WarpX_f.H>
+#include <ScratchArena.H>
 #ifdef WARPX_USE_PY
 #include <WarpX_py.H>
 #endif
@@ -37,6 +38,9 @@ WarpX::EvolveEM (int numsteps)
     for (int step = istep[0]; step < numsteps_max && cur_time < stop_time; ++step)
     {
         Real walltime_beg_step = amrex::second();
+        const long arena_allocs_beg_step = ScratchArena::NumAllocations();
+        const Real comm_exposed_beg_step = comm_time_exposed;
+        const Real comm_hidden_beg_step = comm_time_hidden;
 
 	// Start loop on time steps
         amrex::Print() << "\nSTEP " << step+1 << " starts ...\n";
@@ -46,32 +50,22 @@ WarpX::EvolveEM (int numsteps)
 
         if (costs[0] != nullptr)
         {
-#ifdef WARPX_USE_PSATD
-            amrex::Abort("LoadBalance for PSATD: TODO");
-#endif
-
             if (step > 0 && (step+1) % load_balance_int == 0)
             {
                 LoadBalance();
-		// Reset the costs to 0
-		for (int lev = 0; lev <= finest_level; ++lev) {
-		  costs[lev]->setVal(0.0);
-		}
+                ResetCosts();
             }
 
-            for (int lev = 0; lev <= finest_level; ++lev) {
-	      // Perform running average of the costs
-	      // (Giving more importance to most recent costs)
-	      (*costs[lev].get()).mult( (1. - 2./load_balance_int) );
-            }
+            // Perform running average of the costs
+            // (Giving more importance to most recent costs)
+            ScaleCosts(1. - 2./load_balance_int);
         }
 
         // At the beginning, we have B^{n} and E^{n}.
         // Particles have p^{n} and x^{n}.
         // is_synchronized is true.
         if (is_synchronized) {
-            FillBoundaryE();
-            FillBoundaryB();
+            FillBoundaryEB();
             UpdateAuxilaryData();
             // on first step, push p by -0.5*dt
             for (int lev = 0; lev <= finest_level; ++lev) {
@@ -83,14 +77,13 @@ WarpX::EvolveEM (int numsteps)
         } else {
            // Beyond one step, we have E^{n} and B^{n}.
            // Particles have p^{n-1/2} and x^{n}.
-            FillBoundaryE();
-            FillBoundaryB();
+            FillBoundaryEB();
             UpdateAuxilaryData();
         }
 
         if (do_subcycling == 0 || finest_level == 0) {
             OneStep_nosub(cur_time);
-        } else if (do_subcycling == 1 && finest_level == 1) {
+        } else if (do_subcycling == 1) {
             OneStep_sub1(cur_time);
         } else {
             amrex::Print() << "Error: do_subcycling = " << do_subcycling << std::endl;
@@ -130,16 +123,27 @@ WarpX::EvolveEM (int numsteps)
         // We might need to move j because we are going to make a plotfile.
 
 	int num_moved = MoveWindow(move_j);
-        
-        if (max_level == 0) {
-            int num_redistribute_ghost = num_moved + 1;
-            mypc->RedistributeLocal(num_redistribute_ghost);
+
+        // Rebalance the boxes where the plasma was injected; this
+        // redistributes the particles if boxes are moved
+        bool redistributed = false;
+        if (num_moved != 0 && load_balance_injection && do_plasma_injection
+            && costs[0] != nullptr) {
+            redistributed = LoadBalanceInjectionRegion();
         }
-        else {
-            mypc->Redistribute();
+
+        if (!redistributed) {
+            if (max_level == 0) {
+                int num_redistribute_ghost = num_moved + 1;
+                mypc->RedistributeLocal(num_redistribute_ghost);
+            }
+            else {
+                mypc->Redistribute();
+            }
         }
 
-	bool to_sort = (sort_int > 0) && ((step+1) % sort_int == 0);
+        // With sort_on_redistribute, the particles are already sorted within each tile
+	bool to_sort = (sort_int > 0) && !sort_on_redistribute && ((step+1) % sort_int == 0);
 	if (to_sort) {
 	    amrex::Print() << "re-sorting particles \n";
 	    mypc->SortParticlesByCell();
@@ -152,6 +156,25 @@ WarpX::EvolveEM (int numsteps)
         amrex::Print()<< "Walltime = " << walltime
                       << " s; This step = " << walltime_end_step-walltime_beg_step
                       << " s; Avg. per step = " << walltime/(step+1) << " s\n";
+        if (verbose > 1) {
+            // Memory allocations of the scratch arenas of the particle loops
+            // on the I/O processor (zero once they have reached their size)
+            amrex::Print() << "Scratch arenas: "
+                           << ScratchArena::NumAllocations() - arena_allocs_beg_step
+                           << " allocations this step, "
+                           << ScratchArena::NumBytes() << " bytes\n";
+            if (overlap_field_comm) {
+                // Maximum over the ranks of the time spent in the non-blocking
+                // guard cell exchanges of the field push, and of the time
+                // during which they were overlapped with the push
+                Real comm_times[2] = {comm_time_exposed - comm_exposed_beg_step,
+                                      comm_time_hidden - comm_hidden_beg_step};
+                ParallelDescriptor::ReduceRealMax(comm_times, 2,
+                                                  ParallelDescriptor::IOProcessorNumber());
+                amrex::Print() << "Field guard cell exchanges: " << comm_times[0]
+                               << " s exposed, " << comm_times[1] << " s hidden\n";
+            }
+        }
 
 	// sync up time
 	for (int i = 0; i <= max_level; ++i) {
@@ -168,8 +191,7 @@ WarpX::EvolveEM (int numsteps)
 
 	if (to_make_plot || do_insitu)
         {
-            FillBoundaryE();
-            FillBoundaryB();
+            FillBoundaryEB();
             UpdateAuxilaryData();
 
             for (int lev = 0; lev <= finest_level; ++lev) {
@@ -212,8 +234,7 @@ WarpX::EvolveEM (int numsteps)
 
     if (write_plot_file || do_insitu)
     {
-        FillBoundaryE();
-        FillBoundaryB();
+        FillBoundaryEB();
         UpdateAuxilaryData();
 
         for (int lev = 0; lev <= finest_level; ++lev) {
@@ -271,22 +292,31 @@ WarpX::OneStep_nosub (Real cur_time)
     // (And update guard cells immediately afterwards)
 #ifdef WARPX_USE_PSATD
     PushPSATD(dt[0]);
-    FillBoundaryE();
-    FillBoundaryB();
+    FillBoundaryEB();
+    // With the Galilean solver, E^{n+1} and B^{n+1} are defined on the
+    // grid at its position at t^{n+1}: move the physical domain there
+    ShiftGalileanGrid(dt[0]);
 #else
-    EvolveF(0.5*dt[0], DtType::FirstHalf);
-    FillBoundaryF();
-    EvolveB(0.5*dt[0]); // We now have B^{n+1/2}
-    FillBoundaryB();
-    EvolveE(dt[0]); // We now have E^{n+1}
-    FillBoundaryE();
-    EvolveF(0.5*dt[0], DtType::SecondHalf);
-    EvolveB(0.5*dt[0]); // We now have B^{n+1}
-    if (do_pml) {
-        DampPML();
+    if (fdtd_temporal_blocking) {
+        EvolveBEB(dt[0]); // We now have E^{n+1} and B^{n+1}
+    } else if (overlap_field_comm) {
+        EvolveFieldsOverlapComm(dt[0]); // We now have E^{n+1} and B^{n+1}
+    } else {
+        EvolveF(0.5*dt[0], DtType::FirstHalf);
+        FillBoundaryF();
+        EvolveB(0.5*dt[0]); // We now have B^{n+1/2}
+        FillBoundaryB();
+        EvolveE(dt[0]); // We now have E^{n+1}
         FillBoundaryE();
+        EvolveF(0.5*dt[0], DtType::SecondHalf);
+        EvolveB(0.5*dt[0]); // We now have B^{n+1}
+        if (do_pml) {
+            DampPML();
+            FillBoundaryEB();
+        } else {
+            FillBoundaryB();
+        }
     }
-    FillBoundaryB();
 #endif
 }
 
@@ -294,141 +324,224 @@ WarpX::OneStep_nosub (Real cur_time)
 *  i.e. The fine patch uses a smaller timestep (and steps more often)
 *  than the coarse patch, for the field advance and particle pusher.
 *
-* This version of subcycling only works for 2 levels and with a refinement
-* ratio of 2.
-* The particles and fields of the fine patch are pushed twice
-* (with dt[coarse]/2) in this routine.
-* The particles of the coarse patch and mother grid are pushed only once
-* (with dt[coarse]). The fields on the coarse patch and mother grid
-* are pushed in a way which is equivalent to pushing once only, with
-* a current which is the average of the coarse + fine current at the 2
-* steps of the fine grid.
-*
+* This version of subcycling works for any number of levels, with a
+* refinement ratio rr of 2 or 4: each level performs rr steps per step
+* of the next coarser level.
 */
 void
 WarpX::OneStep_sub1 (Real curtime)
 {
     // TODO: we could save some charge depositions
+    OneStep_sub1(0, curtime);
+}
 
-    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(finest_level == 1, "Must have exactly two levels");
-    const int fine_lev = 1;
-    const int coarse_lev = 0;
-
-    // i) Push particles and fields on the fine patch (first fine step)
-    PushParticlesandDepose(fine_lev, curtime);
-    RestrictCurrentFromFineToCoarsePatch(fine_lev);
-    RestrictRhoFromFineToCoarsePatch(fine_lev);
-    ApplyFilterandSumBoundaryJ(fine_lev, PatchType::fine);
-    NodalSyncJ(fine_lev, PatchType::fine);
-    ApplyFilterandSumBoundaryRho(fine_lev, PatchType::fine, 0, 2);
-    NodalSyncRho(fine_lev, PatchType::fine, 0, 2);
-
-    EvolveB(fine_lev, PatchType::fine, 0.5*dt[fine_lev]);
-    EvolveF(fine_lev, PatchType::fine, 0.5*dt[fine_lev], DtType::FirstHalf);
-    FillBoundaryB(fine_lev, PatchType::fine);
-    FillBoundaryF(fine_lev, PatchType::fine);
-
-    EvolveE(fine_lev, PatchType::fine, dt[fine_lev]);
-    FillBoundaryE(fine_lev, PatchType::fine);
-
-    EvolveB(fine_lev, PatchType::fine, 0.5*dt[fine_lev]);
-    EvolveF(fine_lev, PatchType::fine, 0.5*dt[fine_lev], DtType::SecondHalf);
-
-    if (do_pml) {
-        DampPML(fine_lev, PatchType::fine);
-        FillBoundaryE(fine_lev, PatchType::fine);
-    }
+/* /brief Advance level `lev` (and, recursively, the finer levels) by dt[lev]
+*
+* The particles and fields of the fine patch of `lev+1` are pushed rr times
+* (with dt[lev]/rr) in this routine.
+* The particles of the fine patch of `lev` are pushed only once
+* (with dt[lev]). The fields on the coarse patch of `lev+1` and on the fine
+* patch of `lev` are pushed in a way which is equivalent to pushing once only,
+* with a current which is the average of the coarse + fine current at the rr
+* steps of the fine grid: E is pushed by dt[lev]/rr after each fine step,
+* while B is pushed by dt[lev]/2 before the first and after the last fine step.
+* (With rr = 4, B is therefore at t+dt[lev]/2 when the auxiliary fields of
+* the intermediate fine steps are computed: it is interpolated in time for
+* these, see UpdateAuxilaryDataSubcycling.)
+*/
+void
+WarpX::OneStep_sub1 (int lev, Real curtime)
+{
+    if (lev == finest_level)
+    {
+        // Push particles and fields on the fine patch
+        PushParticlesandDepose(lev, curtime);
+        RestrictCurrentFromFineToCoarsePatch(lev);
+        RestrictRhoFromFineToCoarsePatch(lev);
+        ApplyFilterandSumBoundaryJ(lev, PatchType::fine);
+        NodalSyncJ(lev, PatchType::fine);
+        ApplyFilterandSumBoundaryRho(lev, PatchType::fine, 0, 2);
+        NodalSyncRho(lev, PatchType::fine, 0, 2);
+
+        EvolveB(lev, PatchType::fine, 0.5*dt[lev]);
+        EvolveF(lev, PatchType::fine, 0.5*dt[lev], DtType::FirstHalf);
+        FillBoundaryB(lev, PatchType::fine);
+        FillBoundaryF(lev, PatchType::fine);
+
+        EvolveE(lev, PatchType::fine, dt[lev]);
+        FillBoundaryE(lev, PatchType::fine);
+
+        EvolveB(lev, PatchType::fine, 0.5*dt[lev]);
+        EvolveF(lev, PatchType::fine, 0.5*dt[lev], DtType::SecondHalf);
+
+        if (do_pml) {
+            DampPML(lev, PatchType::fine);
+            FillBoundaryE(lev, PatchType::fine);
+        }
 
-    FillBoundaryB(fine_lev, PatchType::fine);
+        FillBoundaryB(lev, PatchType::fine);
+        FillBoundaryF(lev, PatchType::fine);
+        return;
+    }
 
-    // ii) Push particles on the coarse patch and mother grid.
-    // Push the fields on the coarse patch and mother grid
-    // by only half a coarse step (first half)
-    PushParticlesandDepose(coarse_lev, curtime);
-    StoreCurrent(coarse_lev);
-    AddCurrentFromFineLevelandSumBoundary(coarse_lev);
-    AddRhoFromFineLevelandSumBoundary(coarse_lev, 0, 1);
+    const int fine_lev = lev+1;
+    const int nsub = nsubsteps[fine_lev];
+    for (int isub = 0; isub < nsub; ++isub)
+    {
+        // i) Push particles and fields on the finer levels (one fine step)
+        OneStep_sub1(fine_lev, curtime + isub*dt[fine_lev]);
+
+        // ii) Push particles on the fine patch of lev (first fine step only),
+        // and add the current of the last fine step to their current
+        if (isub == 0) {
+            PushParticlesandDepose(lev, curtime);
+            if (lev > 0) {
+                RestrictCurrentFromFineToCoarsePatch(lev);
+                RestrictRhoFromFineToCoarsePatch(lev);
+            }
+            StoreCurrent(lev);
+        } else {
+            RestoreCurrent(lev);
+        }
+        AddCurrentFromFineLevelandSumBoundary(lev);
+        if (isub == 0) {
+            AddRhoFromFineLevelandSumBoundary(lev, 0, 1);
+        }
+        if (isub == nsub-1) {
+            AddRhoFromFineLevelandSumBoundary(lev, 1, 1);
+        }
 
-    EvolveB(fine_lev, PatchType::coarse, dt[fine_lev]);
-    EvolveF(fine_lev, PatchType::coarse, dt[fine_lev], DtType::FirstHalf);
-    FillBoundaryB(fine_lev, PatchType::coarse);
-    FillBoundaryF(fine_lev, PatchType::coarse);
+        // iii) Push the fields on the coarse patch of the fine level
+        // by one fine step
+        if (isub == 0) {
+            if (nsub > 2) StoreBSubcycling(lev);
+            EvolveB(fine_lev, PatchType::coarse, 0.5*dt[lev]);
+            EvolveF(fine_lev, PatchType::coarse, 0.5*dt[lev], DtType::FirstHalf);
+            FillBoundaryB(fine_lev, PatchType::coarse);
+            FillBoundaryF(fine_lev, PatchType::coarse);
+        }
 
-    EvolveE(fine_lev, PatchType::coarse, dt[fine_lev]);
-    FillBoundaryE(fine_lev, PatchType::coarse);
+        EvolveE(fine_lev, PatchType::coarse, dt[fine_lev]);
+        FillBoundaryE(fine_lev, PatchType::coarse);
 
-    EvolveB(coarse_lev, PatchType::fine, 0.5*dt[coarse_lev]);
-    EvolveF(coarse_lev, PatchType::fine, 0.5*dt[coarse_lev], DtType::FirstHalf);
-    FillBoundaryB(coarse_lev, PatchType::fine);
-    FillBoundaryF(coarse_lev, PatchType::fine);
+        if (isub == nsub-1) {
+            EvolveB(fine_lev, PatchType::coarse, 0.5*dt[lev]);
+            EvolveF(fine_lev, PatchType::coarse, 0.5*dt[lev], DtType::SecondHalf);
 
-    EvolveE(coarse_lev, PatchType::fine, 0.5*dt[coarse_lev]);
-    FillBoundaryE(coarse_lev, PatchType::fine);
+            if (do_pml) {
+                // once per fine step
+                for (int i = 0; i < nsub; ++i) {
+                    DampPML(fine_lev, PatchType::coarse);
+                }
+                FillBoundaryE(fine_lev, PatchType::coarse);
+            }
 
-    // iii) Get auxiliary fields on the fine grid, at dt[fine_lev]
-    UpdateAuxilaryData();
+            FillBoundaryB(fine_lev, PatchType::coarse);
+            FillBoundaryF(fine_lev, PatchType::coarse);
+        }
 
-    // iv) Push particles and fields on the fine patch (second fine step)
-    PushParticlesandDepose(fine_lev, curtime+dt[fine_lev]);
-    RestrictCurrentFromFineToCoarsePatch(fine_lev);
-    RestrictRhoFromFineToCoarsePatch(fine_lev);
-    ApplyFilterandSumBoundaryJ(fine_lev, PatchType::fine);
-    NodalSyncJ(fine_lev, PatchType::fine);
-    ApplyFilterandSumBoundaryRho(fine_lev, PatchType::fine, 0, 2);
-    NodalSyncRho(fine_lev, PatchType::fine, 0, 2);
-
-    EvolveB(fine_lev, PatchType::fine, 0.5*dt[fine_lev]);
-    EvolveF(fine_lev, PatchType::fine, 0.5*dt[fine_lev], DtType::FirstHalf);
-    FillBoundaryB(fine_lev, PatchType::fine);
-    FillBoundaryF(fine_lev, PatchType::fine);
-
-    EvolveE(fine_lev, PatchType::fine, dt[fine_lev]);
-    FillBoundaryE(fine_lev, PatchType::fine);
-
-    EvolveB(fine_lev, PatchType::fine, 0.5*dt[fine_lev]);
-    EvolveF(fine_lev, PatchType::fine, 0.5*dt[fine_lev], DtType::SecondHalf);
-
-    if (do_pml) {
-        DampPML(fine_lev, PatchType::fine);
-        FillBoundaryE(fine_lev, PatchType::fine);
-    }
+        // iv) Push the fields on the fine patch of lev by one fine step
+        if (isub == 0) {
+            EvolveB(lev, PatchType::fine, 0.5*dt[lev]);
+            EvolveF(lev, PatchType::fine, 0.5*dt[lev], DtType::FirstHalf);
+            FillBoundaryB(lev, PatchType::fine);
+            FillBoundaryF(lev, PatchType::fine);
+        }
 
-    FillBoundaryB(fine_lev, PatchType::fine);
-    FillBoundaryF(fine_lev, PatchType::fine);
+        EvolveE(lev, PatchType::fine, dt[fine_lev]);
+        FillBoundaryE(lev, PatchType::fine);
 
-    // v) Push the fields on the coarse patch and mother grid
-    // by only half a coarse step (second half)
-    RestoreCurrent(coarse_lev);
-    AddCurrentFromFineLevelandSumBoundary(coarse_lev);
-    AddRhoFromFineLevelandSumBoundary(coarse_lev, 1, 1);
+        if (isub == nsub-1) {
+            EvolveB(lev, PatchType::fine, 0.5*dt[lev]);
+            EvolveF(lev, PatchType::fine, 0.5*dt[lev], DtType::SecondHalf);
 
-    EvolveE(fine_lev, PatchType::coarse, dt[fine_lev]);
-    FillBoundaryE(fine_lev, PatchType::coarse);
+            if (do_pml) {
+                DampPML(lev, PatchType::fine);
+                FillBoundaryE(lev, PatchType::fine);
+            }
 
-    EvolveB(fine_lev, PatchType::coarse, dt[fine_lev]);
-    EvolveF(fine_lev, PatchType::coarse, dt[fine_lev], DtType::SecondHalf);
+            FillBoundaryB(lev, PatchType::fine);
+        } else {
+            // v) Get auxiliary fields on the fine levels, at the end of
+            // the fine step
+            UpdateAuxilaryDataSubcycling(lev, Real(isub+1)/nsub);
+        }
+    }
+}
 
-    if (do_pml) {
-        DampPML(fine_lev, PatchType::coarse); // do it twice
-        DampPML(fine_lev, PatchType::coarse);
-        FillBoundaryE(fine_lev, PatchType::coarse);
+void
+WarpX::StoreBSubcycling (int lev)
+{
+    const int fine_lev = lev+1;
+    for (int i = 0; i < 6; ++i) {
+        const MultiFab& B = (i < 3) ? *Bfield_fp[lev][i] : *Bfield_cp[fine_lev][i-3];
+        // Only reallocate after regridding or load balancing
+        for (auto store : {&Bfield_sub_start[lev][i], &Bfield_sub_half[lev][i]}) {
+            if (!*store || (*store)->boxArray() != B.boxArray()
+                || (*store)->DistributionMap() != B.DistributionMap())
+            {
+                store->reset(new MultiFab(B.boxArray(), B.DistributionMap(), 1, B.nGrowVect()));
+            }
+        }
+        MultiFab::Copy(*Bfield_sub_start[lev][i], B, 0, 0, 1, B.nGrowVect());
     }
+}
 
-    FillBoundaryB(fine_lev, PatchType::coarse);
-    FillBoundaryF(fine_lev, PatchType::coarse);
+/* /brief Update the auxiliary fields of the fine levels after a fraction
+*  `frac` of the step of level `lev` (with subcycling).
+*
+*  E on the fine patch of `lev` and on the coarse patch of `lev+1` is then at
+*  the same time as the fields of the fine patch of `lev+1`, but B is at the
+*  half step of `lev`. B is interpolated linearly in time (or extrapolated,
+*  for frac > 1/2) from its values at the beginning of the step and at the
+*  half step, for the update of the auxiliary fields only.
+*/
+void
+WarpX::UpdateAuxilaryDataSubcycling (int lev, Real frac)
+{
+    const Real theta = 2.*frac;
+    if (theta == 1.) {
+        UpdateAuxilaryData();
+        return;
+    }
 
-    EvolveE(coarse_lev, PatchType::fine, 0.5*dt[coarse_lev]);
-    FillBoundaryE(coarse_lev, PatchType::fine);
+    BL_PROFILE("UpdateAuxilaryDataSubcycling()");
 
-    EvolveB(coarse_lev, PatchType::fine, 0.5*dt[coarse_lev]);
-    EvolveF(coarse_lev, PatchType::fine, 0.5*dt[coarse_lev], DtType::SecondHalf);
+    const int fine_lev = lev+1;
+    std::array<MultiFab*, 6> B {{
+        Bfield_fp[lev][0].get(), Bfield_fp[lev][1].get(), Bfield_fp[lev][2].get(),
+        Bfield_cp[fine_lev][0].get(), Bfield_cp[fine_lev][1].get(), Bfield_cp[fine_lev][2].get()}};
 
-    if (do_pml) {
-        DampPML(coarse_lev, PatchType::fine);
-        FillBoundaryE(coarse_lev, PatchType::fine);
+    for (int i = 0; i < 6; ++i)
+    {
+        AMREX_ALWAYS_ASSERT(Bfield_sub_start[lev][i] != nullptr);
+        MultiFab::Copy(*Bfield_sub_half[lev][i], *B[i], 0, 0, 1, B[i]->nGrowVect());
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for ( MFIter mfi(*B[i], TilingIfNotGPU()); mfi.isValid(); ++mfi )
+        {
+            const Box& bx = mfi.growntilebox();
+            auto const& Bfab = B[i]->array(mfi);
+            auto const& B0fab = Bfield_sub_start[lev][i]->array(mfi);
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_DEVICE (int j, int k, int l)
+            {
+                Bfab(j,k,l) = B0fab(j,k,l) + theta*(Bfab(j,k,l) - B0fab(j,k,l));
+            });
+        }
     }
+    MarkFieldsModified(lev);
+    MarkFieldsModified(fine_lev);
+
+    UpdateAuxilaryData();
 
-    FillBoundaryB(coarse_lev, PatchType::fine);
+    // Back to B at the half step
+    for (int i = 0; i < 6; ++i) {
+        MultiFab::Copy(*B[i], *Bfield_sub_half[lev][i], 0, 0, 1, B[i]->nGrowVect());
+    }
+    MarkFieldsModified(lev);
+    MarkFieldsModified(fine_lev);
 }
 
 void
@@ -461,7 +574,7 @@ WarpX::ComputeDt ()
     const Real* dx = geom[max_level].CellSize();
     Real deltat = 0.;
 
-    if (maxwell_fdtd_solver_id == 0) {
+    if (maxwell_fdtd_solver_id == 0 || maxwell_fdtd_solver_id == 2) {
       // CFL time step Yee solver
 #ifdef WARPX_RZ
       // Derived semi-analytically by R. Lehe
@@ -471,6 +584,9 @@ WarpX::ComputeDt ()
                                                   + 1./(dx[1]*dx[1]),
                                                   + 1./(dx[2]*dx[2]))) * PhysConst::c );
 #endif
+      // The stencil of the fourth-order solver has a total weight of
+      // 9/8+1/24 = 7/6 (instead of 1 for Yee)
+      if (maxwell_fdtd_solver_id == 2) deltat *= 6./7.;
     } else {
       // CFL time step CKC solver
 #if (BL_SPACEDIM == 3)
@@ -4,37 +4,94 @@
 
 using namespace amrex;
 
+namespace {
+    /* \brief Coefficients of the PSATD update equation, for a given
+     * norm `k_norm` of the modified k vector */
+    struct PsatdCoefficients
+    {
+        Real C, S_ck, X1, X2, X3;
+    };
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    PsatdCoefficients computeCoefficients (const Real k_norm, const Real dt) noexcept
+    {
+        constexpr Real c = PhysConst::c;
+        constexpr Real ep0 = PhysConst::ep0;
+        PsatdCoefficients coef;
+        if (k_norm != 0){
+            coef.C = std::cos(c*k_norm*dt);
+            coef.S_ck = std::sin(c*k_norm*dt)/(c*k_norm);
+            coef.X1 = (1. - coef.C)/(ep0 * c*c * k_norm*k_norm);
+            coef.X2 = (1. - coef.S_ck/dt)/(ep0 * k_norm*k_norm);
+            coef.X3 = (coef.C - coef.S_ck/dt)/(ep0 * k_norm*k_norm);
+        } else { // Handle k_norm = 0, by using the analytical limit
+            coef.C = 1.;
+            coef.S_ck = dt;
+            coef.X1 = 0.5 * dt*dt / ep0;
+            coef.X2 = c*c * dt*dt / (6.*ep0);
+            coef.X3 = - c*c * dt*dt / (3.*ep0);
+        }
+        return coef;
+    }
+
+    /* \brief Index of the point with the same |k| and a positive k,
+     * along a direction with `N` points in spectral space
+     * (see the FFT ordering in SpectralKSpace::getKComponent) */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    int foldIndex (const int i, const int N) noexcept
+    {
+        return (i <= N/2) ? i : N - i;
+    }
+}
+
 /* \brief Initialize coefficients for the update equation */
 PsatdAlgorithm::PsatdAlgorithm(const SpectralKSpace& spectral_kspace,
                          const DistributionMapping& dm,
                          const int norder_x, const int norder_y,
-                         const int norder_z, const bool nodal, const Real dt)
-// Compute and assign the modified k vectors
-: modified_kx_vec(spectral_kspace.getModifiedKComponent(dm,0,norder_x,nodal)),
-#if (AMREX_SPACEDIM==3)
-  modified_ky_vec(spectral_kspace.getModifiedKComponent(dm,1,norder_y,nodal)),
-  modified_kz_vec(spectral_kspace.getModifiedKComponent(dm,2,norder_z,nodal))
-#else
-  modified_kz_vec(spectral_kspace.getModifiedKComponent(dm,1,norder_z,nodal))
-#endif
+                         const int norder_z, const bool nodal, const Real dt,
+                         const PsatdCoefficientsStorage coef_storage)
+// Initialize the modified k vectors in the base class
+: SpectralBaseAlgorithm(spectral_kspace, dm, norder_x, norder_y, norder_z, nodal),
+  coef_storage(coef_storage),
+  dt(dt)
 {
+    // The coefficients are computed in `pushSpectralFields`
+    if (coef_storage == PsatdCoefficientsStorage::OnTheFly) return;
+
     const BoxArray& ba = spectral_kspace.spectralspace_ba;
 
+    // Boxes over which the coefficients are stored: either the full
+    // spectral boxes, or only their part with ky>=0 and kz>=0
+    BoxArray coef_ba = ba;
+    if (coef_storage == PsatdCoefficientsStorage::Octant) {
+        BoxList coef_bl;
+        for (int i=0; i < ba.size(); i++) {
+            IntVect coef_bx_size = ba[i].length();
+            for (int idim=1; idim < AMREX_SPACEDIM; idim++) {
+                coef_bx_size[idim] = coef_bx_size[idim]/2 + 1;
+            }
+            coef_bl.push_back( Box( IntVect::TheZeroVector(),
+                                    coef_bx_size - IntVect::TheUnitVector() ) );
+        }
+        coef_ba.define( coef_bl );
+    }
+
     // Allocate the arrays of coefficients
-    C_coef = SpectralCoefficients(ba, dm, 1, 0);
-    S_ck_coef = SpectralCoefficients(ba, dm, 1, 0);
-    X1_coef = SpectralCoefficients(ba, dm, 1, 0);
-    X2_coef = SpectralCoefficients(ba, dm, 1, 0);
-    X3_coef = SpectralCoefficients(ba, dm, 1, 0);
+    C_coef = SpectralRealCoefficients(coef_ba, dm, 1, 0);
+    S_ck_coef = SpectralRealCoefficients(coef_ba, dm, 1, 0);
+    X1_coef = SpectralRealCoefficients(coef_ba, dm, 1, 0);
+    X2_coef = SpectralRealCoefficients(coef_ba, dm, 1, 0);
+    X3_coef = SpectralRealCoefficients(coef_ba, dm, 1, 0);
 
     // Fill them with the right values:
     // Loop over boxes and allocate the corresponding coefficients
     // for each box owned by the local MPI proc
-    for (MFIter mfi(ba, dm); mfi.isValid(); ++mfi){
+    for (MFIter mfi(coef_ba, dm); mfi.isValid(); ++mfi){
 
-        const Box& bx = ba[mfi];
+        const Box& bx = coef_ba[mfi];
 
         // Extract pointers for the k vectors
+        // (for Octant, the indices of `bx` correspond to ky>=0 and kz>=0)
         const Real* modified_kx = modified_kx_vec[mfi].dataPtr();
 #if (AMREX_SPACEDIM==3)
         const Real* modified_ky = modified_ky_vec[mfi].dataPtr();
@@ -62,21 +119,12 @@ PsatdAlgorithm::PsatdAlgorithm(const SpectralKSpace& spectral_kspace,
 #endif
 
             // Calculate coefficients
-            constexpr Real c = PhysConst::c;
-            constexpr Real ep0 = PhysConst::ep0;
-            if (k_norm != 0){
-                C(i,j,k) = std::cos(c*k_norm*dt);
-                S_ck(i,j,k) = std::sin(c*k_norm*dt)/(c*k_norm);
-                X1(i,j,k) = (1. - C(i,j,k))/(ep0 * c*c * k_norm*k_norm);
-                X2(i,j,k) = (1. - S_ck(i,j,k)/dt)/(ep0 * k_norm*k_norm);
-                X3(i,j,k) = (C(i,j,k) - S_ck(i,j,k)/dt)/(ep0 * k_norm*k_norm);
-            } else { // Handle k_norm = 0, by using the analytical limit
-                C(i,j,k) = 1.;
-                S_ck(i,j,k) = dt;
-                X1(i,j,k) = 0.5 * dt*dt / ep0;
-                X2(i,j,k) = c*c * dt*dt / (6.*ep0);
-                X3(i,j,k) = - c*c * dt*dt / (3.*ep0);
-            }
+            const PsatdCoefficients coef = computeCoefficients(k_norm, dt);
+            C(i,j,k) = coef.C;
+            S_ck(i,j,k) = coef.S_ck;
+            X1(i,j,k) = coef.X1;
+            X2(i,j,k) = coef.X2;
+            X3(i,j,k) = coef.X3;
         });
     }
 };
@@ -93,12 +141,23 @@ PsatdAlgorithm::pushSpectralFields(SpectralFieldData& f) const{
 
         // Extract arrays for the fields to be updated
         Array4<Complex> fields = f.fields[mfi].array();
-        // Extract arrays for the coefficients
-        Array4<const Real> C_arr = C_coef[mfi].array();
-        Array4<const Real> S_ck_arr = S_ck_coef[mfi].array();
-        Array4<const Real> X1_arr = X1_coef[mfi].array();
-        Array4<const Real> X2_arr = X2_coef[mfi].array();
-        Array4<const Real> X3_arr = X3_coef[mfi].array();
+        // Extract arrays for the coefficients (if they are stored)
+        const bool on_the_fly = (coef_storage == PsatdCoefficientsStorage::OnTheFly);
+        const bool octant = (coef_storage == PsatdCoefficientsStorage::Octant);
+        Array4<const Real> C_arr, S_ck_arr, X1_arr, X2_arr, X3_arr;
+        if (!on_the_fly) {
+            C_arr = C_coef[mfi].array();
+            S_ck_arr = S_ck_coef[mfi].array();
+            X1_arr = X1_coef[mfi].array();
+            X2_arr = X2_coef[mfi].array();
+            X3_arr = X3_coef[mfi].array();
+        }
+        // Number of points along y and z in spectral space (for Octant)
+        const int ny = bx.length(1);
+#if (AMREX_SPACEDIM==3)
+        const int nz = bx.length(2);
+#endif
+        const Real dt = this->dt;
         // Extract pointers for the k vectors
         const Real* modified_kx_arr = modified_kx_vec[mfi].dataPtr();
 #if (AMREX_SPACEDIM==3)
@@ -136,11 +195,30 @@ PsatdAlgorithm::pushSpectralFields(SpectralFieldData& f) const{
             constexpr Real c2 = PhysConst::c*PhysConst::c;
             constexpr Real inv_ep0 = 1./PhysConst::ep0;
             constexpr Complex I = Complex{0,1};
-            const Real C = C_arr(i,j,k);
-            const Real S_ck = S_ck_arr(i,j,k);
-            const Real X1 = X1_arr(i,j,k);
-            const Real X2 = X2_arr(i,j,k);
-            const Real X3 = X3_arr(i,j,k);
+            PsatdCoefficients coef;
+            if (on_the_fly) {
+                coef = computeCoefficients(
+                    std::sqrt(kx*kx + ky*ky + kz*kz), dt);
+            } else {
+                // Index of the stored coefficients
+                // (for Octant: the point with the same |k| and ky>=0, kz>=0)
+                const int jc = octant ? foldIndex(j, ny) : j;
+#if (AMREX_SPACEDIM==3)
+                const int kc = octant ? foldIndex(k, nz) : k;
+#else
+                const int kc = k;
+#endif
+                coef.C = C_arr(i,jc,kc);
+                coef.S_ck = S_ck_arr(i,jc,kc);
+                coef.X1 = X1_arr(i,jc,kc);
+                coef.X2 = X2_arr(i,jc,kc);
+                coef.X3 = X3_arr(i,jc,kc);
+            }
+            const Real C = coef.C;
+            const Real S_ck = coef.S_ck;
+            const Real X1 = coef.X1;
+            const Real X2 = coef.X2;
+            const Real X3 = coef.X3;
 
             // Update E (see WarpX online documentation: theory section)
             fields(i,j,k,Idx::Ex) = C*Ex_old
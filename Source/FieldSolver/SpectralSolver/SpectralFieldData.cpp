@@ -5,7 +5,9 @@ using namespace amrex;
 /* \brief Initialize fields in spectral space, and FFT plans */
 SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
                             const SpectralKSpace& k_space,
-                            const DistributionMapping& dm )
+                            const DistributionMapping& dm,
+                            const int fftw_plan_measure )
+    : fftw_plan_measure(fftw_plan_measure)
 {
     const BoxArray& spectralspace_ba = k_space.spectralspace_ba;
 
@@ -14,10 +16,11 @@ SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
     fields = SpectralField(spectralspace_ba, dm,
                             SpectralFieldIndex::n_fields, 0);
 
-    // Allocate temporary arrays - in real space and spectral space
-    // These arrays will store the data just before/after the FFT
-    tmpRealField = SpectralField(realspace_ba, dm, 1, 0);
-    tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    // Allocate temporary array in real space, with enough components
+    // to transform all the fields in one batch
+    // This array will store the data just before/after the FFT
+    tmpRealField = RealSpaceField(realspace_ba, dm,
+                                  SpectralFieldIndex::n_fields, 0);
 
     // By default, we assume the FFT is done from/to a nodal grid in real space
     // It the FFT is performed from/to a cell-centered grid in real space,
@@ -42,57 +45,101 @@ SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
                                     ShiftType::TransformToCellCentered);
 #endif
 
-    // Allocate and initialize the FFT plans
-    forward_plan = FFTplans(spectralspace_ba, dm);
-    backward_plan = FFTplans(spectralspace_ba, dm);
-    // Loop over boxes and allocate the corresponding plan
-    // for each box owned by the local MPI proc
-    for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
-        Box bx = spectralspace_ba[mfi];
-#ifdef AMREX_USE_GPU
-        // Add cuFFT-specific code
-#else
-        // Create FFTW plans
-        forward_plan[mfi] =
-            // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
-#if (AMREX_SPACEDIM == 3)
-            fftw_plan_dft_3d( bx.length(2), bx.length(1), bx.length(0),
-#else
-            fftw_plan_dft_2d( bx.length(1), bx.length(0),
-#endif
-            reinterpret_cast<fftw_complex*>( tmpRealField[mfi].dataPtr() ),
-            reinterpret_cast<fftw_complex*>( tmpSpectralField[mfi].dataPtr() ),
-            FFTW_FORWARD, FFTW_ESTIMATE );
-        backward_plan[mfi] =
-            // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
-#if (AMREX_SPACEDIM == 3)
-            fftw_plan_dft_3d( bx.length(2), bx.length(1), bx.length(0),
-#else
-            fftw_plan_dft_2d( bx.length(1), bx.length(0),
-#endif
-            reinterpret_cast<fftw_complex*>( tmpSpectralField[mfi].dataPtr() ),
-            reinterpret_cast<fftw_complex*>( tmpRealField[mfi].dataPtr() ),
-            FFTW_BACKWARD, FFTW_ESTIMATE );
-#endif
-    }
+    // The FFT plans are created on first use (see `getPlan`), since they
+    // depend on which fields are transformed together
 }
 
 
 SpectralFieldData::~SpectralFieldData()
 {
-    if (tmpRealField.size() > 0){
-        for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
+    for (auto* plans : {&forward_plans, &backward_plans}) {
+        for (auto& kv : *plans) {
+            for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
 #ifdef AMREX_USE_GPU
-            // Add cuFFT-specific code
+                // Add cuFFT-specific code
 #else
-            // Destroy FFTW plans
-            fftw_destroy_plan( forward_plan[mfi] );
-            fftw_destroy_plan( backward_plan[mfi] );
+                // Destroy FFTW plans
+                if (kv.second[mfi]) fftw_destroy_plan( kv.second[mfi] );
 #endif
+            }
         }
     }
 }
 
+#ifndef AMREX_USE_GPU
+/* \brief Return the FFTW plan that transforms the box `mfi` of the
+ *  `n_fields` consecutive spectral fields that start at `first_field_index`
+ *  (and the first `n_fields` components of `tmpRealField`), in one batch.
+ *  The plan is created on the first call. */
+fftw_plan
+SpectralFieldData::getPlan( const MFIter& mfi, const bool forward,
+                            const int first_field_index, const int n_fields )
+{
+    auto& plans = forward ? forward_plans : backward_plans;
+    const auto key = std::make_pair(first_field_index, n_fields);
+    auto it = plans.find(key);
+    if (it == plans.end()) {
+        it = plans.emplace(key, FFTplans(tmpRealField.boxArray(),
+                                         tmpRealField.DistributionMap())).first;
+    }
+    fftw_plan& plan = it->second[mfi];
+    if (plan) return plan;
+
+    unsigned flags = FFTW_ESTIMATE;
+    if (fftw_plan_measure == 1) {
+        flags = FFTW_MEASURE;
+    } else if (fftw_plan_measure >= 2) {
+        flags = FFTW_PATIENT;
+    }
+
+    // The plans are defined by the number of points in *real* space
+    // (FFTW infers the reduced size along x in spectral space)
+    // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order,
+    // so that the x dimension (halved by the real-to-complex transform)
+    // is the last, contiguous dimension for FFTW
+    const Box realspace_bx = tmpRealField[mfi].box();
+    const Box spectralspace_bx = fields[mfi].box();
+#if (AMREX_SPACEDIM == 3)
+    int n[3] = {realspace_bx.length(2), realspace_bx.length(1), realspace_bx.length(0)};
+#else
+    int n[2] = {realspace_bx.length(1), realspace_bx.length(0)};
+#endif
+    // The fields of the batch are the successive components of the FABs
+    const int real_dist = realspace_bx.numPts();
+    const int spectral_dist = spectralspace_bx.numPts();
+    Real* real_ptr = tmpRealField[mfi].dataPtr(0);
+    fftw_complex* spectral_ptr =
+        reinterpret_cast<fftw_complex*>( fields[mfi].dataPtr(first_field_index) );
+
+    // Planning with FFTW_MEASURE/FFTW_PATIENT overwrites the arrays:
+    // save the spectral fields, which may contain data at this point
+    BaseFab<Complex> backup;
+    if (flags != FFTW_ESTIMATE) {
+        backup.resize(spectralspace_bx, n_fields);
+        backup.copy(fields[mfi], first_field_index, 0, n_fields);
+    }
+
+    if (forward) {
+        plan = fftw_plan_many_dft_r2c( AMREX_SPACEDIM, n, n_fields,
+                                       real_ptr, nullptr, 1, real_dist,
+                                       spectral_ptr, nullptr, 1, spectral_dist,
+                                       flags );
+    } else {
+        // Note: the complex-to-real transform overwrites its input
+        plan = fftw_plan_many_dft_c2r( AMREX_SPACEDIM, n, n_fields,
+                                       spectral_ptr, nullptr, 1, spectral_dist,
+                                       real_ptr, nullptr, 1, real_dist,
+                                       flags );
+    }
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(plan != nullptr, "FFTW plan creation failed");
+
+    if (flags != FFTW_ESTIMATE) {
+        fields[mfi].copy(backup, 0, first_field_index, n_fields);
+    }
+    return plan;
+}
+#endif
+
 /* \brief Transform the component `i_comp` of MultiFab `mf`
  *  to spectral space, and store the corresponding result internally
  *  (in the spectral field specified by `field_index`) */
@@ -101,60 +148,80 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
                                      const int field_index,
                                      const int i_comp )
 {
-    // Check field index type, in order to apply proper shift in spectral space
-    const bool is_nodal_x = mf.is_nodal(0);
-#if (AMREX_SPACEDIM == 3)
-    const bool is_nodal_y = mf.is_nodal(1);
-    const bool is_nodal_z = mf.is_nodal(2);
-#else
-    const bool is_nodal_z = mf.is_nodal(1);
-#endif
+    ForwardTransform( {&mf}, {i_comp}, field_index );
+}
+
+/* \brief Transform the components `i_comp[n]` of the MultiFabs `mf[n]`
+ *  to spectral space, with one batched FFT per box, and store the
+ *  results in the consecutive spectral fields that start at
+ *  `first_field_index` */
+void
+SpectralFieldData::ForwardTransform( const Vector<const MultiFab*>& mf,
+                                     const Vector<int>& i_comp,
+                                     const int first_field_index )
+{
+    const int n_fields = mf.size();
+    AMREX_ALWAYS_ASSERT( static_cast<int>(i_comp.size()) == n_fields );
+    AMREX_ALWAYS_ASSERT( first_field_index + n_fields <= SpectralFieldIndex::n_fields );
 
     // Loop over boxes
-    for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
+    for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
+
+#ifndef AMREX_USE_GPU
+        // Get the plan first: its creation may overwrite the arrays
+        fftw_plan plan = getPlan( mfi, true, first_field_index, n_fields );
+#endif
 
-        // Copy the real-space field `mf` to the temporary field `tmpRealField`
+        // Copy the real-space fields `mf` to the temporary field `tmpRealField`
         // This ensures that all fields have the same number of points
         // before the Fourier transform.
         // As a consequence, the copy discards the *last* point of `mf`
         // in any direction that has *nodal* index type.
-        {
-            Box realspace_bx = mf[mfi].box(); // Copy the box
+        for (int n=0; n<n_fields; n++) {
+            Box realspace_bx = (*mf[n])[mfi].box(); // Copy the box
             realspace_bx.enclosedCells(); // Discard last point in nodal direction
             AMREX_ALWAYS_ASSERT( realspace_bx == tmpRealField[mfi].box() );
-            Array4<const Real> mf_arr = mf[mfi].array();
-            Array4<Complex> tmp_arr = tmpRealField[mfi].array();
+            Array4<const Real> mf_arr = (*mf[n])[mfi].array();
+            Array4<Real> tmp_arr = tmpRealField[mfi].array();
+            const int src_comp = i_comp[n];
             ParallelFor( realspace_bx,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                tmp_arr(i,j,k) = mf_arr(i,j,k,i_comp);
+                tmp_arr(i,j,k,n) = mf_arr(i,j,k,src_comp);
             });
         }
 
-        // Perform Fourier transform from `tmpRealField` to `tmpSpectralField`
+        // Perform Fourier transform from `tmpRealField` to the
+        // components of `fields` (all the fields in one batch)
 #ifdef AMREX_USE_GPU
         // Add cuFFT-specific code ; make sure that this is done on the same
         // GPU stream as the above copy
 #else
-        fftw_execute( forward_plan[mfi] );
+        fftw_execute( plan );
 #endif
 
-        // Copy the spectral-space field `tmpSpectralField` to the appropriate
-        // index of the FabArray `fields` (specified by `field_index`)
-        // and apply correcting shift factor if the real space data comes
+        // Apply correcting shift factor if the real space data comes
         // from a cell-centered grid in real space instead of a nodal grid.
-        {
+        for (int n=0; n<n_fields; n++) {
+            // Check field index type, in order to apply proper shift in spectral space
+            const bool is_nodal_x = mf[n]->is_nodal(0);
+#if (AMREX_SPACEDIM == 3)
+            const bool is_nodal_y = mf[n]->is_nodal(1);
+            const bool is_nodal_z = mf[n]->is_nodal(2);
+#else
+            const bool is_nodal_z = mf[n]->is_nodal(1);
+#endif
             Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
-            Array4<const Complex> tmp_arr = tmpSpectralField[mfi].array();
+            const int field_index = first_field_index + n;
             const Complex* xshift_arr = xshift_FFTfromCell[mfi].dataPtr();
 #if (AMREX_SPACEDIM == 3)
             const Complex* yshift_arr = yshift_FFTfromCell[mfi].dataPtr();
 #endif
             const Complex* zshift_arr = zshift_FFTfromCell[mfi].dataPtr();
             // Loop over indices within one box
-            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+            const Box spectralspace_bx = fields[mfi].box();
             ParallelFor( spectralspace_bx,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                Complex spectral_field_value = tmp_arr(i,j,k);
+                Complex spectral_field_value = fields_arr(i,j,k,field_index);
                 // Apply proper shift in each dimension
                 if (is_nodal_x==false) spectral_field_value *= xshift_arr[i];
 #if (AMREX_SPACEDIM == 3)
@@ -163,7 +230,6 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
 #elif (AMREX_SPACEDIM == 2)
                 if (is_nodal_z==false) spectral_field_value *= zshift_arr[j];
 #endif
-                // Copy field into the right index
                 fields_arr(i,j,k,field_index) = spectral_field_value;
             });
         }
@@ -178,35 +244,57 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
                                       const int field_index,
                                       const int i_comp )
 {
-    // Check field index type, in order to apply proper shift in spectral space
-    const bool is_nodal_x = mf.is_nodal(0);
-#if (AMREX_SPACEDIM == 3)
-    const bool is_nodal_y = mf.is_nodal(1);
-    const bool is_nodal_z = mf.is_nodal(2);
-#else
-    const bool is_nodal_z = mf.is_nodal(1);
-#endif
+    BackwardTransform( {&mf}, {i_comp}, field_index );
+}
+
+/* \brief Transform the consecutive spectral fields that start at
+ * `first_field_index` back to real space, with one batched FFT per box,
+ * and store them in the components `i_comp[n]` of the MultiFabs `mf[n]`
+ *
+ * The transformed spectral fields are overwritten in the process
+ * (they are reloaded by the next forward transform). */
+void
+SpectralFieldData::BackwardTransform( const Vector<MultiFab*>& mf,
+                                      const Vector<int>& i_comp,
+                                      const int first_field_index )
+{
+    const int n_fields = mf.size();
+    AMREX_ALWAYS_ASSERT( static_cast<int>(i_comp.size()) == n_fields );
+    AMREX_ALWAYS_ASSERT( first_field_index + n_fields <= SpectralFieldIndex::n_fields );
 
     // Loop over boxes
-    for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
+    for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
+
+#ifndef AMREX_USE_GPU
+        // Get the plan first: its creation may overwrite the arrays
+        fftw_plan plan = getPlan( mfi, false, first_field_index, n_fields );
+#endif
 
-        // Copy the spectral-space field `tmpSpectralField` to the appropriate
-        // field (specified by the input argument field_index)
-        // and apply correcting shift factor if the field is to be transformed
-        // to a cell-centered grid in real space instead of a nodal grid.
+        // Apply correcting shift factor (in place) if the field is to be
+        // transformed to a cell-centered grid in real space instead of a
+        // nodal grid.
         // Normalize (divide by 1/N) since the FFT+IFFT results in a factor N
-        {
-            Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].array();
-            Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
+        for (int n=0; n<n_fields; n++) {
+            // Check field index type, in order to apply proper shift in spectral space
+            const bool is_nodal_x = mf[n]->is_nodal(0);
+#if (AMREX_SPACEDIM == 3)
+            const bool is_nodal_y = mf[n]->is_nodal(1);
+            const bool is_nodal_z = mf[n]->is_nodal(2);
+#else
+            const bool is_nodal_z = mf[n]->is_nodal(1);
+#endif
+            Array4<Complex> field_arr = SpectralFieldData::fields[mfi].array();
+            const int field_index = first_field_index + n;
             const Complex* xshift_arr = xshift_FFTtoCell[mfi].dataPtr();
 #if (AMREX_SPACEDIM == 3)
             const Complex* yshift_arr = yshift_FFTtoCell[mfi].dataPtr();
 #endif
             const Complex* zshift_arr = zshift_FFTtoCell[mfi].dataPtr();
             // Loop over indices within one box
-            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+            const Box spectralspace_bx = fields[mfi].box();
             // For normalization: divide by the number of points in the box
-            const Real inv_N = 1./spectralspace_bx.numPts();
+            // (in real space, since only half of the kx are stored)
+            const Real inv_N = 1./tmpRealField[mfi].box().numPts();
             ParallelFor( spectralspace_bx,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
                 Complex spectral_field_value = field_arr(i,j,k,field_index);
@@ -218,27 +306,29 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
 #elif (AMREX_SPACEDIM == 2)
                 if (is_nodal_z==false) spectral_field_value *= zshift_arr[j];
 #endif
-                // Copy field into temporary array (after normalization)
-                tmp_arr(i,j,k) = inv_N*spectral_field_value;
+                // Store the field back (after normalization)
+                field_arr(i,j,k,field_index) = inv_N*spectral_field_value;
             });
         }
 
-        // Perform Fourier transform from `tmpSpectralField` to `tmpRealField`
+        // Perform Fourier transform from the components of `fields`
+        // to `tmpRealField` (all the fields in one batch)
 #ifdef AMREX_USE_GPU
         // Add cuFFT-specific code ; make sure that this is done on the same
         // GPU stream as the above copy
 #else
-        fftw_execute( backward_plan[mfi] );
+        fftw_execute( plan );
 #endif
 
-        // Copy the temporary field `tmpRealField` to the real-space field `mf`
-        {
+        // Copy the temporary field `tmpRealField` to the real-space fields `mf`
+        for (int n=0; n<n_fields; n++) {
             const Box realspace_bx = tmpRealField[mfi].box();
-            Array4<Real> mf_arr = mf[mfi].array();
-            Array4<const Complex> tmp_arr = tmpRealField[mfi].array();
+            Array4<Real> mf_arr = (*mf[n])[mfi].array();
+            Array4<const Real> tmp_arr = tmpRealField[mfi].array();
+            const int dst_comp = i_comp[n];
             ParallelFor( realspace_bx,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                mf_arr(i,j,k,i_comp) = tmp_arr(i,j,k).real();
+                mf_arr(i,j,k,dst_comp) = tmp_arr(i,j,k,n);
             });
         }
     }
@@ -15,7 +15,8 @@ using namespace Gpu;
 SpectralKSpace::SpectralKSpace( const BoxArray& realspace_ba,
                                 const DistributionMapping& dm,
                                 const RealVect realspace_dx )
-    : dx(realspace_dx)  // Store the cell size as member `dx`
+    : realspace_ba(realspace_ba),
+      dx(realspace_dx)  // Store the cell size as member `dx`
 {
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
         realspace_ba.ixType()==IndexType::TheCellType(),
@@ -27,13 +28,16 @@ SpectralKSpace::SpectralKSpace( const BoxArray& realspace_ba,
     for (int i=0; i < realspace_ba.size(); i++ ) {
         // For local FFTs, boxes in spectral space start at 0 in
         // each direction and have the same number of points as the
-        // (cell-centered) real space box
-        // TODO: this will be different for the real-to-complex FFT
+        // (cell-centered) real space box, except along x: since the
+        // fields are real, the real-to-complex FFT only computes the
+        // N/2+1 non-negative kx (the values at negative kx are the
+        // complex conjugates of those at -kx)
         // TODO: this will be different for the hybrid FFT scheme
         Box realspace_bx = realspace_ba[i];
-        Print() << realspace_bx.smallEnd() << " " << realspace_bx.bigEnd() << std::endl;
+        IntVect spectral_bx_size = realspace_bx.length();
+        spectral_bx_size[0] = spectral_bx_size[0]/2 + 1;
         Box bx = Box( IntVect::TheZeroVector(),
-                      realspace_bx.bigEnd() - realspace_bx.smallEnd() );
+                      spectral_bx_size - IntVect::TheUnitVector() );
         spectral_bl.push_back( bx );
     }
     spectralspace_ba.define( spectral_bl );
@@ -60,26 +64,35 @@ SpectralKSpace::getKComponent( const DistributionMapping& dm,
         Box bx = spectralspace_ba[mfi];
         ManagedVector<Real>& k = k_comp[mfi];
 
-        // Allocate k to the right size
-        int N = bx.length( i_dim );
-        k.resize( N );
+        // Number of points in real space, and in spectral space
+        const int N = realspace_ba[mfi].length( i_dim );
+        const int N_spectral = bx.length( i_dim );
+        k.resize( N_spectral );
 
         // Fill the k vector
         const Real dk = 2*MathConst::pi/(N*dx[i_dim]);
         AMREX_ALWAYS_ASSERT_WITH_MESSAGE( bx.smallEnd(i_dim) == 0,
             "Expected box to start at 0, in spectral space.");
-        AMREX_ALWAYS_ASSERT_WITH_MESSAGE( bx.bigEnd(i_dim) == N-1,
-            "Expected different box end index in spectral space.");
-        const int mid_point = (N+1)/2;
-        // Fill positive values of k (FFT conventions: first half is positive)
-        for (int i=0; i<mid_point; i++ ){
-            k[i] = i*dk;
-        }
-        // Fill negative values of k (FFT conventions: second half is negative)
-        for (int i=mid_point; i<N; i++){
-            k[i] = (i-N)*dk;
+        if (i_dim == 0) {
+            // Real-to-complex FFT along x: only the non-negative kx
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE( N_spectral == N/2+1,
+                "Expected different box end index in spectral space.");
+            for (int i=0; i<N_spectral; i++ ){
+                k[i] = i*dk;
+            }
+        } else {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE( N_spectral == N,
+                "Expected different box end index in spectral space.");
+            const int mid_point = (N+1)/2;
+            // Fill positive values of k (FFT conventions: first half is positive)
+            for (int i=0; i<mid_point; i++ ){
+                k[i] = i*dk;
+            }
+            // Fill negative values of k (FFT conventions: second half is negative)
+            for (int i=mid_point; i<N; i++){
+                k[i] = (i-N)*dk;
+            }
         }
-        // TODO: this will be different for the real-to-complex transform
         // TODO: this will be different for the hybrid FFT scheme
     }
     return k_comp;
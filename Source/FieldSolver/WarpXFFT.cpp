@@ -1,7 +1,15 @@
 
 #include <WarpX.H>
 #include <WarpX_f.H>
+#include <WarpXComm_K.H>
 #include <AMReX_iMultiFab.H>
+#include <AMReX_Utility.H>
+
+#include <cstring>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace amrex;
 
@@ -10,57 +18,6 @@ constexpr int WarpX::FFTData::N;
 namespace {
 static std::unique_ptr<WarpX::FFTData> nullfftdata; // This for process with nz_fft=0
 
-/** \brief Returns an "owner mask" which 1 for all cells, except
- *  for the duplicated (physical) cells of a nodal grid.
- *
- *  More precisely, for these cells (which are represented on several grids)
- *  the owner mask is 1 only if these cells are at the lower left end of
- *  the local grid - or if these cells are at the end of the physical domain
- *  Therefore, there for these cells, there will be only one grid for
- *  which the owner mask is non-zero.
- */
-static iMultiFab
-BuildFFTOwnerMask (const MultiFab& mf, const Geometry& geom)
-{
-    const BoxArray& ba = mf.boxArray();
-    const DistributionMapping& dm = mf.DistributionMap();
-    iMultiFab mask(ba, dm, 1, 0);
-    const int owner = 1;
-    const int nonowner = 0;
-    mask.setVal(owner);
-
-    const Box& domain_box = amrex::convert(geom.Domain(), ba.ixType());
-
-    AMREX_ASSERT(ba.complementIn(domain_box).isEmpty());
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-    for (MFIter mfi(mask); mfi.isValid(); ++mfi)
-    {
-        IArrayBox& fab = mask[mfi];
-        const Box& bx = fab.box();
-        Box bx2 = bx;
-        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-            // Detect nodal dimensions
-            if (bx2.type(idim) == IndexType::NODE) {
-                // Make sure that this grid does not touch the end of
-                // the physical domain.
-                if (bx2.bigEnd(idim) < domain_box.bigEnd(idim)) {
-                    bx2.growHi(idim, -1);
-                }
-            }
-        }
-        const BoxList& bl = amrex::boxDiff(bx, bx2);
-        // Set owner mask in these cells
-        for (const auto& b : bl) {
-            fab.setVal(nonowner, b, 0, 1);
-        }
-    }
-
-    return mask;
-}
-
 /** \brief Copy the data from the FFT grid to the regular grid
  *
  * Because, for nodal grid, some cells are duplicated on several boxes,
@@ -70,12 +27,16 @@ BuildFFTOwnerMask (const MultiFab& mf, const Geometry& geom)
  * one box.
  */
 static void
-CopyDataFromFFTToValid (MultiFab& mf, const MultiFab& mf_fft, const BoxArray& ba_valid_fft, const Geometry& geom)
+CopyDataFromFFTToValid (MultiFab& mf, const MultiFab& mf_fft, const BoxArray& ba_valid_fft)
 {
     auto idx_type = mf_fft.ixType();
     MultiFab mftmp(amrex::convert(ba_valid_fft,idx_type), mf_fft.DistributionMap(), 1, 0);
 
-    const iMultiFab& mask = BuildFFTOwnerMask(mftmp, geom);
+    // For the duplicated (nodal) cells, the mask is 1 on only one box.
+    // (This does not assume that the boxes cover the whole domain,
+    // so that it also works for the patches of the refined levels.)
+    const auto mask_ptr = mftmp.OwnerMask();
+    const iMultiFab& mask = *mask_ptr;
 
     // Local copy: whenever an MPI rank owns both the data from the FFT
     // grid and from the regular grid, for overlapping region, copy it locally
@@ -109,34 +70,149 @@ CopyDataFromFFTToValid (MultiFab& mf, const MultiFab& mf_fft, const BoxArray& ba
     mf.ParallelAdd(mftmp);
 }
 
+/** \brief Fill the FFT boxes of a patch of a refined level with the fields
+ *  of the parent level: copied (rr = 1, for the coarse patch, which has the
+ *  cell size of the parent level) or interpolated to the fine grid (for the
+ *  fine patch; linear along the nodal directions of the field, piecewise
+ *  constant along the others).
+ *
+ *  PushPSATDSinglePatch then overwrites the cells that the patch covers, so
+ *  that the guard cells of the FFT boxes that stick out of the patch hold the
+ *  fields of the parent level.
+ */
+static void
+FillFFTFromParent (MultiFab& mf_fft, const MultiFab& mf_parent, int rr,
+                   const Periodicity& crse_period)
+{
+    const int ncomp = mf_fft.nComp();
+    if (rr == 1) {
+        mf_fft.setVal(0.0);
+        mf_fft.ParallelCopy(mf_parent, 0, 0, ncomp, 0, 0, crse_period);
+        return;
+    }
+
+    // Parent fields under the FFT boxes (with one more cell for the interpolation)
+    BoxArray ba_crse = amrex::coarsen(mf_fft.boxArray(), rr);
+    ba_crse.grow(1);
+    MultiFab crse(ba_crse, mf_fft.DistributionMap(), ncomp, 0);
+    crse.setVal(0.0);
+    crse.ParallelCopy(mf_parent, 0, 0, ncomp, 0, 0, crse_period);
+
+    const IntVect nodal = mf_fft.ixType().toIntVect();
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(mf_fft, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        auto const& fft = mf_fft.array(mfi);
+        auto const& c = crse.array(mfi);
+        AMREX_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+        {
+            fft(i,j,k,n) = warpx_interp_linear_crse(i,j,k,n,c,nodal,rr);
+        });
+    }
+}
+
+/** \brief Push the fields of one patch (fine or coarse) with the local
+ *  spectral solver: copy them to the FFT grid, push them in spectral
+ *  space, and copy E and B back to the regular grid.
+ */
+static void
+PushPSATDSinglePatch (SpectralSolver& solver,
+                      std::array<std::unique_ptr<MultiFab>,3>& Efield,
+                      std::array<std::unique_ptr<MultiFab>,3>& Bfield,
+                      const std::array<std::unique_ptr<MultiFab>,3>& current,
+                      const std::unique_ptr<MultiFab>& rho,
+                      std::array<std::unique_ptr<MultiFab>,3>& Efield_fft,
+                      std::array<std::unique_ptr<MultiFab>,3>& Bfield_fft,
+                      std::array<std::unique_ptr<MultiFab>,3>& current_fft,
+                      std::unique_ptr<MultiFab>& rho_fft,
+                      const BoxArray& ba_valid_fft, const Periodicity& period)
+{
+    BL_PROFILE_VAR_NS("WarpXFFT::CopyDualGrid", blp_copy);
+    BL_PROFILE_VAR_NS("WarpXFFT::PushSpectral", blp_push);
+
+    BL_PROFILE_VAR_START(blp_copy);
+    for (int i = 0; i < 3; ++i) {
+        Efield_fft[i]->ParallelCopy(*Efield[i], 0, 0, 1, 0, 0, period);
+        Bfield_fft[i]->ParallelCopy(*Bfield[i], 0, 0, 1, 0, 0, period);
+        current_fft[i]->ParallelCopy(*current[i], 0, 0, 1, 0, 0, period);
+    }
+    rho_fft->ParallelCopy(*rho, 0, 0, 2, 0, 0, period);
+    BL_PROFILE_VAR_STOP(blp_copy);
+
+    BL_PROFILE_VAR_START(blp_push);
+    // Perform forward Fourier transform
+    // (all the fields, from Ex to rho_new, in one batch per box)
+    solver.ForwardTransform(
+        {Efield_fft[0].get(), Efield_fft[1].get(), Efield_fft[2].get(),
+         Bfield_fft[0].get(), Bfield_fft[1].get(), Bfield_fft[2].get(),
+         current_fft[0].get(), current_fft[1].get(), current_fft[2].get(),
+         rho_fft.get(), rho_fft.get()},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
+        SpectralFieldIndex::Ex);
+
+    // Advance fields in spectral space
+    solver.pushSpectralFields();
+
+    // Perform backward Fourier Transform
+    // (E and B, in one batch per box)
+    solver.BackwardTransform(
+        {Efield_fft[0].get(), Efield_fft[1].get(), Efield_fft[2].get(),
+         Bfield_fft[0].get(), Bfield_fft[1].get(), Bfield_fft[2].get()},
+        {0, 0, 0, 0, 0, 0},
+        SpectralFieldIndex::Ex);
+    BL_PROFILE_VAR_STOP(blp_push);
+
+    BL_PROFILE_VAR_START(blp_copy);
+    for (int i = 0; i < 3; ++i) {
+        CopyDataFromFFTToValid(*Efield[i], *Efield_fft[i], ba_valid_fft);
+        CopyDataFromFFTToValid(*Bfield[i], *Bfield_fft[i], ba_valid_fft);
+    }
+    BL_PROFILE_VAR_STOP(blp_copy);
+}
+
 }
 
 void
 WarpX::AllocLevelDataFFT (int lev)
 {
-    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(lev == 0, "PSATD doesn't work with mesh refinement yet");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(lev == 0 || fft_hybrid_mpi_decomposition == false,
+        "PSATD with mesh refinement requires psatd.hybrid_mpi_decomposition = 0");
 
     static_assert(std::is_standard_layout<FFTData>::value, "FFTData must have standard layout");
     static_assert(sizeof(FFTData) == sizeof(void*)*FFTData::N, "sizeof FFTData is wrong");
 
-    InitFFTComm(lev);
+    // Cell size of a level, in the format of the spectral solver
+    auto CellSizeVect = [] (int l) {
+        std::array<Real,3> dx = CellSize(l);
+#if (AMREX_SPACEDIM == 3)
+        return RealVect(dx[0], dx[1], dx[2]);
+#elif (AMREX_SPACEDIM == 2)
+        return RealVect(dx[0], dx[2]);
+#endif
+    };
 
     BoxArray ba_fp_fft;
     DistributionMapping dm_fp_fft;
-    FFTDomainDecomposition(lev, ba_fp_fft, dm_fp_fft, ba_valid_fp_fft[lev], domain_fp_fft[lev],
-                           geom[lev].Domain());
+    if (fft_hybrid_mpi_decomposition){
+        InitFFTComm(lev);
+        FFTDomainDecomposition(lev, ba_fp_fft, dm_fp_fft, ba_valid_fp_fft[lev], domain_fp_fft[lev],
+                               geom[lev].Domain());
+    } else {
+        if (!fftw_initialized) InitFFTW();
+
+        // Local FFTs: one FFT box per grid box (with guard cells)
+        LocalFFTDomainDecomposition(boxArray(lev), DistributionMap(lev),
+                                    ba_fp_fft, dm_fp_fft, ba_valid_fp_fft[lev]);
 
-    if (fft_hybrid_mpi_decomposition == false){
         // Allocate and initialize objects for the spectral solver
         // (all use the same distribution mapping)
-        std::array<Real,3> dx = CellSize(lev);
-#if (AMREX_SPACEDIM == 3)
-        RealVect dx_vect(dx[0], dx[1], dx[2]);
-#elif (AMREX_SPACEDIM == 2)
-        RealVect dx_vect(dx[0], dx[2]);
-#endif
         spectral_solver_fp[lev].reset( new SpectralSolver( ba_fp_fft, dm_fp_fft,
-                 nox_fft, noy_fft, noz_fft, do_nodal, dx_vect, dt[lev] ) );
+                 nox_fft, noy_fft, noz_fft, do_nodal,
+                 {v_galilean[0], v_galilean[1], v_galilean[2]}, CellSizeVect(lev), dt[lev],
+                 fftw_plan_measure, psatd_coefficients_storage ) );
     }
 
     // rho2 has one extra ghost cell, so that it's safe to deposit charge density after
@@ -163,14 +239,23 @@ WarpX::AllocLevelDataFFT (int lev)
     rho_fp_fft[lev].reset(new MultiFab(amrex::convert(ba_fp_fft,IntVect::TheNodeVector()),
                                        dm_fp_fft, 2, 0));
 
-    dataptr_fp_fft[lev].reset(new LayoutData<FFTData>(ba_fp_fft, dm_fp_fft));
+    if (fft_hybrid_mpi_decomposition){
+        dataptr_fp_fft[lev].reset(new LayoutData<FFTData>(ba_fp_fft, dm_fp_fft));
+    }
 
     if (lev > 0)
     {
+        // Coarse patch (only with local FFTs, see the assertion above)
         BoxArray ba_cp_fft;
         DistributionMapping dm_cp_fft;
-        FFTDomainDecomposition(lev, ba_cp_fft, dm_cp_fft, ba_valid_cp_fft[lev], domain_cp_fft[lev],
-                               amrex::coarsen(geom[lev].Domain(),2));
+        LocalFFTDomainDecomposition(amrex::coarsen(boxArray(lev), refRatio(lev-1)),
+                                    DistributionMap(lev),
+                                    ba_cp_fft, dm_cp_fft, ba_valid_cp_fft[lev]);
+
+        spectral_solver_cp[lev].reset( new SpectralSolver( ba_cp_fft, dm_cp_fft,
+                 nox_fft, noy_fft, noz_fft, do_nodal,
+                 {v_galilean[0], v_galilean[1], v_galilean[2]}, CellSizeVect(lev-1), dt[lev],
+                 fftw_plan_measure, psatd_coefficients_storage ) );
 
         Efield_cp_fft[lev][0].reset(new MultiFab(amrex::convert(ba_cp_fft,Ex_nodal_flag),
                                                  dm_cp_fft, 1, 0));
@@ -192,11 +277,11 @@ WarpX::AllocLevelDataFFT (int lev)
                                                   dm_cp_fft, 1, 0));
         rho_cp_fft[lev].reset(new MultiFab(amrex::convert(ba_cp_fft,IntVect::TheNodeVector()),
                                            dm_cp_fft, 2, 0));
-
-        dataptr_cp_fft[lev].reset(new LayoutData<FFTData>(ba_cp_fft, dm_cp_fft));
     }
 
-    InitFFTDataPlan(lev);
+    if (fft_hybrid_mpi_decomposition){
+        InitFFTDataPlan(lev);
+    }
 }
 
 /** \brief Create MPI sub-communicators for each FFT group,
@@ -319,6 +404,47 @@ WarpX::FFTDomainDecomposition (int lev, BoxArray& ba_fft, DistributionMapping& d
     ba_valid.define(std::move(bl_valid));
 }
 
+/** \brief Domain decomposition for the local FFTs (i.e. without the hybrid
+ *  decomposition): each grid box of `ba` gives an FFT box, extended by the
+ *  guard cells of the spectral solver, with the same distribution mapping.
+ *
+ *  Since it follows the regular grids, this works for the patches of the
+ *  refined levels, and is simply rebuilt when the distribution mapping
+ *  changes (see RemakeLevel).
+ *  - ba_fft: the FFT boxes (including the guard cells)
+ *  - dm_fft: their distribution mapping (the one of `ba`)
+ *  - ba_valid: the valid part of the FFT boxes (i.e. the boxes of `ba`)
+ */
+void
+WarpX::LocalFFTDomainDecomposition (const BoxArray& ba, const DistributionMapping& dm,
+                                    BoxArray& ba_fft, DistributionMapping& dm_fft,
+                                    BoxArray& ba_valid)
+{
+#if (AMREX_SPACEDIM == 3)
+    const IntVect nguards_fft(nox_fft/2, noy_fft/2, noz_fft/2);
+#else
+    const IntVect nguards_fft(nox_fft/2, noz_fft/2);
+#endif
+    ba_valid = ba;
+    ba_fft = ba;
+    ba_fft.grow(nguards_fft);
+    dm_fft = dm;
+}
+
+/** \brief Settings of the FFTW planner, for the local FFTs:
+ *  number of threads, and wisdom from the previous runs
+ */
+void
+WarpX::InitFFTW ()
+{
+#ifdef _OPENMP
+    if (fftw_init_threads() == 0) amrex::Abort("fftw_init_threads failed");
+    fftw_plan_with_nthreads( fftw_nthreads > 0 ? fftw_nthreads : omp_get_max_threads() );
+#endif
+    if (!fftw_wisdom_file.empty()) ImportFFTWWisdom();
+    fftw_initialized = true;
+}
+
 /** /brief Set all the flags and metadata of the PICSAR FFT module.
  *         Allocate the auxiliary arrays of `fft_data`
  *
@@ -365,9 +491,13 @@ WarpX::InitFFTDataPlan (int lev)
 void
 WarpX::FreeFFT (int lev)
 {
-    nullfftdata.reset();
+    spectral_solver_fp[lev].reset();
+    spectral_solver_cp[lev].reset();
 
-    warpx_fft_nullify();
+    if (fft_hybrid_mpi_decomposition) {
+        nullfftdata.reset();
+        warpx_fft_nullify();
+    }
 
     if (comm_fft[lev] != MPI_COMM_NULL) {
         MPI_Comm_free(&comm_fft[lev]);
@@ -375,18 +505,140 @@ WarpX::FreeFFT (int lev)
     comm_fft[lev] = MPI_COMM_NULL;
 }
 
+/** \brief Load the FFTW wisdom from `psatd.fftw_wisdom_file` (if it exists)
+ *
+ *  The file is read by the I/O processor and broadcast to all ranks. FFTW
+ *  then reuses the stored parameters for any plan with the same shape
+ *  (box size, number of fields in the batch, planner flags) instead of
+ *  measuring them again.
+ */
+void
+WarpX::ImportFFTWWisdom ()
+{
+    int file_exists = 0;
+    if (ParallelDescriptor::IOProcessor()) {
+        file_exists = amrex::FileExists(fftw_wisdom_file);
+    }
+    ParallelDescriptor::Bcast(&file_exists, 1, ParallelDescriptor::IOProcessorNumber());
+    if (!file_exists) return;
+
+    Vector<char> wisdom;
+    ParallelDescriptor::ReadAndBcastFile(fftw_wisdom_file, wisdom);
+    if (!fftw_import_wisdom_from_string(wisdom.dataPtr())) {
+        amrex::Warning("Could not import the FFTW wisdom from " + fftw_wisdom_file);
+    }
+}
+
+/** \brief Write the FFTW wisdom of all ranks to `psatd.fftw_wisdom_file`
+ *
+ *  Each rank only has the wisdom of the plans of its own boxes:
+ *  it is gathered on the I/O processor, which merges it and writes the file.
+ */
+void
+WarpX::ExportFFTWWisdom ()
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int ioproc = ParallelDescriptor::IOProcessorNumber();
+    MPI_Comm comm = ParallelDescriptor::Communicator();
+
+    char* local_wisdom = fftw_export_wisdom_to_string();
+    int local_size = std::strlen(local_wisdom) + 1; // Include the terminating null
+
+    Vector<int> sizes(nprocs, 0), offsets(nprocs, 0);
+    MPI_Gather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, ioproc, comm);
+    for (int i = 1; i < nprocs; ++i) {
+        offsets[i] = offsets[i-1] + sizes[i-1];
+    }
+    Vector<char> all_wisdom(ParallelDescriptor::IOProcessor() ? offsets[nprocs-1]+sizes[nprocs-1] : 0);
+    MPI_Gatherv(local_wisdom, local_size, MPI_CHAR, all_wisdom.data(), sizes.data(),
+                offsets.data(), MPI_CHAR, ioproc, comm);
+    fftw_free(local_wisdom);
+
+    if (ParallelDescriptor::IOProcessor()) {
+        for (int i = 0; i < nprocs; ++i) {
+            fftw_import_wisdom_from_string(&all_wisdom[offsets[i]]);
+        }
+        if (!fftw_export_wisdom_to_filename(fftw_wisdom_file.c_str())) {
+            amrex::Warning("Could not write the FFTW wisdom to " + fftw_wisdom_file);
+        }
+    }
+}
+
 void
 WarpX::PushPSATD (amrex::Real a_dt)
 {
-    for (int lev = 0; lev <= finest_level; ++lev) {
+    // From the finest level down, so that the refined levels read the
+    // fields of their parent level at t^n (see FillFFTGuardRing)
+    for (int lev = finest_level; lev >= 0; --lev) {
         AMREX_ALWAYS_ASSERT_WITH_MESSAGE(dt[lev] == a_dt, "dt must be consistent");
         PushPSATD(lev, a_dt);
     }
+
+    // The FFT plans are created during the first push (and after each
+    // load balance, see RemakeLevel): save the corresponding wisdom for
+    // the next runs
+    if (!fft_hybrid_mpi_decomposition && !fftw_wisdom_file.empty() && !fftw_wisdom_saved) {
+        ExportFFTWWisdom();
+        fftw_wisdom_saved = true;
+    }
+}
+
+/** \brief Fill the FFT boxes of the fine and coarse patches of the refined
+ *  level lev with the fields of level lev-1 (see FillFFTFromParent).
+ *
+ *  The FFT boxes extend the boxes of the patches by the guard cells of the
+ *  spectral solver. Where they stick out of the patch, this gives the
+ *  spectral push the fields of the parent level, as the guard cells of a
+ *  FillPatch would. There is no PML around the patches with PSATD.
+ */
+void
+WarpX::FillFFTGuardRing (int lev)
+{
+    BL_PROFILE("WarpX::FillFFTGuardRing()");
+
+    const int rr = refRatio(lev-1)[0];
+    const auto& crse_period = geom[lev-1].periodicity();
+    for (int i = 0; i < 3; ++i)
+    {
+        FillFFTFromParent(*Efield_fp_fft[lev][i], *Efield_fp[lev-1][i], rr, crse_period);
+        FillFFTFromParent(*Bfield_fp_fft[lev][i], *Bfield_fp[lev-1][i], rr, crse_period);
+        FillFFTFromParent(*current_fp_fft[lev][i], *current_fp[lev-1][i], rr, crse_period);
+        FillFFTFromParent(*Efield_cp_fft[lev][i], *Efield_fp[lev-1][i], 1, crse_period);
+        FillFFTFromParent(*Bfield_cp_fft[lev][i], *Bfield_fp[lev-1][i], 1, crse_period);
+        FillFFTFromParent(*current_cp_fft[lev][i], *current_fp[lev-1][i], 1, crse_period);
+    }
+    FillFFTFromParent(*rho_fp_fft[lev], *rho_fp[lev-1], rr, crse_period);
+    FillFFTFromParent(*rho_cp_fft[lev], *rho_fp[lev-1], 1, crse_period);
 }
 
 void
 WarpX::PushPSATD (int lev, amrex::Real /* dt */)
 {
+    MarkFieldsModified(lev);
+
+    if (fft_hybrid_mpi_decomposition == false){
+        // Local FFTs: push the fine patch, and the coarse patch on refined
+        // levels (which are then combined in UpdateAuxilaryData, as for
+        // the FDTD solver)
+        if (lev > 0) FillFFTGuardRing(lev);
+        PushPSATDSinglePatch(*spectral_solver_fp[lev], Efield_fp[lev], Bfield_fp[lev],
+                             current_fp[lev], rho_fp[lev],
+                             Efield_fp_fft[lev], Bfield_fp_fft[lev],
+                             current_fp_fft[lev], rho_fp_fft[lev],
+                             ba_valid_fp_fft[lev], geom[lev].periodicity());
+        if (lev > 0)
+        {
+            PushPSATDSinglePatch(*spectral_solver_cp[lev], Efield_cp[lev], Bfield_cp[lev],
+                                 current_cp[lev], rho_cp[lev],
+                                 Efield_cp_fft[lev], Bfield_cp_fft[lev],
+                                 current_cp_fft[lev], rho_cp_fft[lev],
+                                 ba_valid_cp_fft[lev], geom[lev-1].periodicity());
+        }
+        return;
+    }
+
+    // Hybrid decomposition: global FFTs within each FFT group (PICSAR)
+    // (only on level 0, see AllocLevelDataFFT)
     BL_PROFILE_VAR_NS("WarpXFFT::CopyDualGrid", blp_copy);
     BL_PROFILE_VAR_NS("PICSAR::FftPushEB", blp_push_eb);
 
@@ -406,88 +658,54 @@ WarpX::PushPSATD (int lev, amrex::Real /* dt */)
     BL_PROFILE_VAR_STOP(blp_copy);
 
     BL_PROFILE_VAR_START(blp_push_eb);
-    if (fft_hybrid_mpi_decomposition){
-        if (Efield_fp_fft[lev][0]->local_size() == 1)
-           //Only one FFT patch on this MPI
-        {
-        	for (MFIter mfi(*Efield_fp_fft[lev][0]); mfi.isValid(); ++mfi)
-        	{
-                    warpx_fft_push_eb(WARPX_TO_FORTRAN_ANYD((*Efield_fp_fft[lev][0])[mfi]),
-                                      WARPX_TO_FORTRAN_ANYD((*Efield_fp_fft[lev][1])[mfi]),
-                                      WARPX_TO_FORTRAN_ANYD((*Efield_fp_fft[lev][2])[mfi]),
-                                      WARPX_TO_FORTRAN_ANYD((*Bfield_fp_fft[lev][0])[mfi]),
-                                      WARPX_TO_FORTRAN_ANYD((*Bfield_fp_fft[lev][1])[mfi]),
-                                      WARPX_TO_FORTRAN_ANYD((*Bfield_fp_fft[lev][2])[mfi]),
-                                      WARPX_TO_FORTRAN_ANYD((*current_fp_fft[lev][0])[mfi]),
-                                      WARPX_TO_FORTRAN_ANYD((*current_fp_fft[lev][1])[mfi]),
-                                      WARPX_TO_FORTRAN_ANYD((*current_fp_fft[lev][2])[mfi]),
-                                      WARPX_TO_FORTRAN_N_ANYD((*rho_fp_fft[lev])[mfi],0),
-                                      WARPX_TO_FORTRAN_N_ANYD((*rho_fp_fft[lev])[mfi],1));
-        	}
-        }
-        else if (Efield_fp_fft[lev][0]->local_size() == 0)
-          // No FFT patch on this MPI rank
-          // Still need to call the MPI-FFT routine.
-        {
-        	FArrayBox fab(Box(IntVect::TheZeroVector(), IntVect::TheUnitVector()));
-        	warpx_fft_push_eb(WARPX_TO_FORTRAN_ANYD(fab),
-        			  WARPX_TO_FORTRAN_ANYD(fab),
-        			  WARPX_TO_FORTRAN_ANYD(fab),
-        			  WARPX_TO_FORTRAN_ANYD(fab),
-        			  WARPX_TO_FORTRAN_ANYD(fab),
-        			  WARPX_TO_FORTRAN_ANYD(fab),
-        			  WARPX_TO_FORTRAN_ANYD(fab),
-        			  WARPX_TO_FORTRAN_ANYD(fab),
-        			  WARPX_TO_FORTRAN_ANYD(fab),
-        			  WARPX_TO_FORTRAN_ANYD(fab),
-        			  WARPX_TO_FORTRAN_ANYD(fab));
-        }
-        else
-          // Multiple FFT patches on this MPI rank
-        {
-    	amrex::Abort("WarpX::PushPSATD: TODO");
-        }
-    } else {
-        // Not using the hybrid decomposition
-        auto& solver = *spectral_solver_fp[lev];
-
-        // Perform forward Fourier transform
-        solver.ForwardTransform(*Efield_fp_fft[lev][0], SpectralFieldIndex::Ex);
-        solver.ForwardTransform(*Efield_fp_fft[lev][1], SpectralFieldIndex::Ey);
-        solver.ForwardTransform(*Efield_fp_fft[lev][2], SpectralFieldIndex::Ez);
-        solver.ForwardTransform(*Bfield_fp_fft[lev][0], SpectralFieldIndex::Bx);
-        solver.ForwardTransform(*Bfield_fp_fft[lev][1], SpectralFieldIndex::By);
-        solver.ForwardTransform(*Bfield_fp_fft[lev][2], SpectralFieldIndex::Bz);
-        solver.ForwardTransform(*current_fp_fft[lev][0], SpectralFieldIndex::Jx);
-        solver.ForwardTransform(*current_fp_fft[lev][1], SpectralFieldIndex::Jy);
-        solver.ForwardTransform(*current_fp_fft[lev][2], SpectralFieldIndex::Jz);
-        solver.ForwardTransform(*rho_fp_fft[lev], SpectralFieldIndex::rho_old, 0);
-        solver.ForwardTransform(*rho_fp_fft[lev], SpectralFieldIndex::rho_new, 1);
-
-        // Advance fields in spectral space
-        solver.pushSpectralFields();
-
-        // Perform backward Fourier Transform
-        solver.BackwardTransform(*Efield_fp_fft[lev][0], SpectralFieldIndex::Ex);
-        solver.BackwardTransform(*Efield_fp_fft[lev][1], SpectralFieldIndex::Ey);
-        solver.BackwardTransform(*Efield_fp_fft[lev][2], SpectralFieldIndex::Ez);
-        solver.BackwardTransform(*Bfield_fp_fft[lev][0], SpectralFieldIndex::Bx);
-        solver.BackwardTransform(*Bfield_fp_fft[lev][1], SpectralFieldIndex::By);
-        solver.BackwardTransform(*Bfield_fp_fft[lev][2], SpectralFieldIndex::Bz);
+    if (Efield_fp_fft[lev][0]->local_size() == 1)
+       //Only one FFT patch on this MPI
+    {
+    	for (MFIter mfi(*Efield_fp_fft[lev][0]); mfi.isValid(); ++mfi)
+    	{
+                warpx_fft_push_eb(WARPX_TO_FORTRAN_ANYD((*Efield_fp_fft[lev][0])[mfi]),
+                                  WARPX_TO_FORTRAN_ANYD((*Efield_fp_fft[lev][1])[mfi]),
+                                  WARPX_TO_FORTRAN_ANYD((*Efield_fp_fft[lev][2])[mfi]),
+                                  WARPX_TO_FORTRAN_ANYD((*Bfield_fp_fft[lev][0])[mfi]),
+                                  WARPX_TO_FORTRAN_ANYD((*Bfield_fp_fft[lev][1])[mfi]),
+                                  WARPX_TO_FORTRAN_ANYD((*Bfield_fp_fft[lev][2])[mfi]),
+                                  WARPX_TO_FORTRAN_ANYD((*current_fp_fft[lev][0])[mfi]),
+                                  WARPX_TO_FORTRAN_ANYD((*current_fp_fft[lev][1])[mfi]),
+                                  WARPX_TO_FORTRAN_ANYD((*current_fp_fft[lev][2])[mfi]),
+                                  WARPX_TO_FORTRAN_N_ANYD((*rho_fp_fft[lev])[mfi],0),
+                                  WARPX_TO_FORTRAN_N_ANYD((*rho_fp_fft[lev])[mfi],1));
+    	}
+    }
+    else if (Efield_fp_fft[lev][0]->local_size() == 0)
+      // No FFT patch on this MPI rank
+      // Still need to call the MPI-FFT routine.
+    {
+    	FArrayBox fab(Box(IntVect::TheZeroVector(), IntVect::TheUnitVector()));
+    	warpx_fft_push_eb(WARPX_TO_FORTRAN_ANYD(fab),
+    			  WARPX_TO_FORTRAN_ANYD(fab),
+    			  WARPX_TO_FORTRAN_ANYD(fab),
+    			  WARPX_TO_FORTRAN_ANYD(fab),
+    			  WARPX_TO_FORTRAN_ANYD(fab),
+    			  WARPX_TO_FORTRAN_ANYD(fab),
+    			  WARPX_TO_FORTRAN_ANYD(fab),
+    			  WARPX_TO_FORTRAN_ANYD(fab),
+    			  WARPX_TO_FORTRAN_ANYD(fab),
+    			  WARPX_TO_FORTRAN_ANYD(fab),
+    			  WARPX_TO_FORTRAN_ANYD(fab));
+    }
+    else
+      // Multiple FFT patches on this MPI rank
+    {
+	amrex::Abort("WarpX::PushPSATD: TODO");
     }
     BL_PROFILE_VAR_STOP(blp_push_eb);
 
     BL_PROFILE_VAR_START(blp_copy);
-    CopyDataFromFFTToValid(*Efield_fp[lev][0], *Efield_fp_fft[lev][0], ba_valid_fp_fft[lev], geom[lev]);
-    CopyDataFromFFTToValid(*Efield_fp[lev][1], *Efield_fp_fft[lev][1], ba_valid_fp_fft[lev], geom[lev]);
-    CopyDataFromFFTToValid(*Efield_fp[lev][2], *Efield_fp_fft[lev][2], ba_valid_fp_fft[lev], geom[lev]);
-    CopyDataFromFFTToValid(*Bfield_fp[lev][0], *Bfield_fp_fft[lev][0], ba_valid_fp_fft[lev], geom[lev]);
-    CopyDataFromFFTToValid(*Bfield_fp[lev][1], *Bfield_fp_fft[lev][1], ba_valid_fp_fft[lev], geom[lev]);
-    CopyDataFromFFTToValid(*Bfield_fp[lev][2], *Bfield_fp_fft[lev][2], ba_valid_fp_fft[lev], geom[lev]);
+    CopyDataFromFFTToValid(*Efield_fp[lev][0], *Efield_fp_fft[lev][0], ba_valid_fp_fft[lev]);
+    CopyDataFromFFTToValid(*Efield_fp[lev][1], *Efield_fp_fft[lev][1], ba_valid_fp_fft[lev]);
+    CopyDataFromFFTToValid(*Efield_fp[lev][2], *Efield_fp_fft[lev][2], ba_valid_fp_fft[lev]);
+    CopyDataFromFFTToValid(*Bfield_fp[lev][0], *Bfield_fp_fft[lev][0], ba_valid_fp_fft[lev]);
+    CopyDataFromFFTToValid(*Bfield_fp[lev][1], *Bfield_fp_fft[lev][1], ba_valid_fp_fft[lev]);
+    CopyDataFromFFTToValid(*Bfield_fp[lev][2], *Bfield_fp_fft[lev][2], ba_valid_fp_fft[lev]);
     BL_PROFILE_VAR_STOP(blp_copy);
-
-    if (lev > 0)
-    {
-        amrex::Abort("WarpX::PushPSATD: TODO");
-    }
 }
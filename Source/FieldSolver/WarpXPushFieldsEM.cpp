@@ -16,28 +16,200 @@
 
 using namespace amrex;
 
+namespace
+{
+    // Number of cells reached by the stencil of the field push, on each side
+    int stencilReach ()
+    {
+        return (!WarpX::do_nodal && WarpX::maxwell_fdtd_solver_id == 2) ? 2 : 1;
+    }
+
+    // Solver of the PML kernels (0: Yee, 1: CKC); the PML uses the Yee
+    // solver with the fourth-order solver
+    int pmlSolverType ()
+    {
+        return (WarpX::maxwell_fdtd_solver_id == 1) ? 1 : 0;
+    }
+
+    // Parts of the tile box tbx of one field component that belong to region.
+    // The interior is the part whose stencil does not reach the guard cells
+    // of the valid box vbx.
+    BoxList regionBoxes (const Box& tbx, const Box& vbx, FieldRegion region)
+    {
+        if (region == FieldRegion::full) return BoxList(tbx);
+        const Box interior = tbx & amrex::convert(amrex::grow(vbx,-stencilReach()), tbx.ixType());
+        if (region == FieldRegion::interior) {
+            return interior.ok() ? BoxList(interior) : BoxList(tbx.ixType());
+        }
+        return interior.ok() ? amrex::boxDiff(tbx, interior) : BoxList(tbx);
+    }
+
+    // Calls push(tbx,tby,tbz) on the parts of the tile boxes of the three
+    // components that belong to region (with empty boxes for the other
+    // components, when they are split)
+    template <typename F>
+    void forEachRegionBox (const Box& tbx, const Box& tby, const Box& tbz,
+                           const Box& vbx, FieldRegion region, F&& push)
+    {
+        if (region == FieldRegion::full) {
+            push(tbx, tby, tbz);
+            return;
+        }
+        const Box empty(IntVect::TheUnitVector(), IntVect::TheZeroVector());
+        for (const Box& b : regionBoxes(tbx, vbx, region)) push(b, empty, empty);
+        for (const Box& b : regionBoxes(tby, vbx, region)) push(empty, b, empty);
+        for (const Box& b : regionBoxes(tbz, vbx, region)) push(empty, empty, b);
+    }
+
+    // Staggered FDTD push of B, of E and of the grad F term of E, in the
+    // boxes tbx, tby and tbz of the box mfi, with the stencil of solver
+    template <typename Solver>
+    void pushB (const MFIter& mfi, const Box& tbx, const Box& tby, const Box& tbz,
+                const std::array<MultiFab*,3>& E, const std::array<MultiFab*,3>& B,
+                const Solver& solver)
+    {
+        auto const& Bxfab = B[0]->array(mfi);
+        auto const& Byfab = B[1]->array(mfi);
+        auto const& Bzfab = B[2]->array(mfi);
+        auto const& Exfab = E[0]->array(mfi);
+        auto const& Eyfab = E[1]->array(mfi);
+        auto const& Ezfab = E[2]->array(mfi);
+        amrex::ParallelFor(tbx,
+        [=] AMREX_GPU_DEVICE (int j, int k, int l)
+        {
+            warpx_push_bx(j,k,l,Bxfab,Eyfab,Ezfab,solver);
+        });
+        amrex::ParallelFor(tby,
+        [=] AMREX_GPU_DEVICE (int j, int k, int l)
+        {
+            warpx_push_by(j,k,l,Byfab,Exfab,Ezfab,solver);
+        });
+        amrex::ParallelFor(tbz,
+        [=] AMREX_GPU_DEVICE (int j, int k, int l)
+        {
+            warpx_push_bz(j,k,l,Bzfab,Exfab,Eyfab,solver);
+        });
+    }
+
+    template <typename Solver>
+    void pushE (const MFIter& mfi, const Box& tex, const Box& tey, const Box& tez,
+                const std::array<MultiFab*,3>& E, const std::array<MultiFab*,3>& B,
+                const std::array<MultiFab*,3>& J, Real mu_c2_dt, const Solver& solver)
+    {
+        auto const& Exfab = E[0]->array(mfi);
+        auto const& Eyfab = E[1]->array(mfi);
+        auto const& Ezfab = E[2]->array(mfi);
+        auto const& Bxfab = B[0]->array(mfi);
+        auto const& Byfab = B[1]->array(mfi);
+        auto const& Bzfab = B[2]->array(mfi);
+        auto const& jxfab = J[0]->array(mfi);
+        auto const& jyfab = J[1]->array(mfi);
+        auto const& jzfab = J[2]->array(mfi);
+        amrex::ParallelFor(tex,
+        [=] AMREX_GPU_DEVICE (int j, int k, int l)
+        {
+            warpx_push_ex(j,k,l,Exfab,Byfab,Bzfab,jxfab,mu_c2_dt,solver);
+        });
+        amrex::ParallelFor(tey,
+        [=] AMREX_GPU_DEVICE (int j, int k, int l)
+        {
+            warpx_push_ey(j,k,l,Eyfab,Bxfab,Bzfab,jyfab,mu_c2_dt,solver);
+        });
+        amrex::ParallelFor(tez,
+        [=] AMREX_GPU_DEVICE (int j, int k, int l)
+        {
+            warpx_push_ez(j,k,l,Ezfab,Bxfab,Byfab,jzfab,mu_c2_dt,solver);
+        });
+    }
+
+    template <typename Solver>
+    void pushEF (const MFIter& mfi, const Box& tex, const Box& tey, const Box& tez,
+                 const std::array<MultiFab*,3>& E, MultiFab* F, const Solver& solver)
+    {
+        auto const& Exfab = E[0]->array(mfi);
+        auto const& Eyfab = E[1]->array(mfi);
+        auto const& Ezfab = E[2]->array(mfi);
+        auto const& Ffab = F->array(mfi);
+        amrex::ParallelFor(tex,
+        [=] AMREX_GPU_DEVICE (int j, int k, int l)
+        {
+            warpx_push_ex_f(j,k,l,Exfab,Ffab,solver);
+        });
+        amrex::ParallelFor(tey,
+        [=] AMREX_GPU_DEVICE (int j, int k, int l)
+        {
+            warpx_push_ey_f(j,k,l,Eyfab,Ffab,solver);
+        });
+        amrex::ParallelFor(tez,
+        [=] AMREX_GPU_DEVICE (int j, int k, int l)
+        {
+            warpx_push_ez_f(j,k,l,Ezfab,Ffab,solver);
+        });
+    }
+
+    // Same as above, with the solver selected by algo.maxwell_fdtd_solver
+    // (0: Yee, 1: CKC, 2: fourth order), for the cell size dx.
+    // The stencil coefficients include the factor dt of the push.
+    void pushBFDTD (const MFIter& mfi, const Box& tbx, const Box& tby, const Box& tbz,
+                    const std::array<MultiFab*,3>& E, const std::array<MultiFab*,3>& B,
+                    const std::array<Real,3>& dx, Real dt)
+    {
+        switch (WarpX::maxwell_fdtd_solver_id) {
+        case 1:  pushB(mfi, tbx, tby, tbz, E, B, CKCSolver(dx, dt)); break;
+        case 2:  pushB(mfi, tbx, tby, tbz, E, B, FourthOrderSolver(dx, dt)); break;
+        default: pushB(mfi, tbx, tby, tbz, E, B, YeeSolver(dx, dt));
+        }
+    }
+
+    // The E push is the same with Yee and CKC
+    void pushEFDTD (const MFIter& mfi, const Box& tex, const Box& tey, const Box& tez,
+                    const std::array<MultiFab*,3>& E, const std::array<MultiFab*,3>& B,
+                    const std::array<MultiFab*,3>& J, Real mu_c2_dt,
+                    const std::array<Real,3>& dx, Real c2dt)
+    {
+        if (WarpX::maxwell_fdtd_solver_id == 2) {
+            pushE(mfi, tex, tey, tez, E, B, J, mu_c2_dt, FourthOrderSolver(dx, c2dt));
+        } else {
+            pushE(mfi, tex, tey, tez, E, B, J, mu_c2_dt, YeeSolver(dx, c2dt));
+        }
+    }
+
+    void pushEFFDTD (const MFIter& mfi, const Box& tex, const Box& tey, const Box& tez,
+                     const std::array<MultiFab*,3>& E, MultiFab* F,
+                     const std::array<Real,3>& dx, Real c2dt)
+    {
+        switch (WarpX::maxwell_fdtd_solver_id) {
+        case 1:  pushEF(mfi, tex, tey, tez, E, F, CKCSolver(dx, c2dt)); break;
+        case 2:  pushEF(mfi, tex, tey, tez, E, F, FourthOrderSolver(dx, c2dt)); break;
+        default: pushEF(mfi, tex, tey, tez, E, F, YeeSolver(dx, c2dt));
+        }
+    }
+}
+
 void
-WarpX::EvolveB (Real dt)
+WarpX::EvolveB (Real dt, FieldRegion region)
 {
     for (int lev = 0; lev <= finest_level; ++lev) {
-        EvolveB(lev, dt);
+        EvolveB(lev, dt, region);
     }
 }
 
 void
-WarpX::EvolveB (int lev, Real dt)
+WarpX::EvolveB (int lev, Real dt, FieldRegion region)
 {
     BL_PROFILE("WarpX::EvolveB()");
-    EvolveB(lev, PatchType::fine, dt);
+    EvolveB(lev, PatchType::fine, dt, region);
     if (lev > 0)
     {
-        EvolveB(lev, PatchType::coarse, dt);
+        EvolveB(lev, PatchType::coarse, dt, region);
     }
 }
 
 void
-WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real dt)
+WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real dt, FieldRegion region)
 {
+    MarkFieldsModified(lev);
+
     const int patch_level = (patch_type == PatchType::fine) ? lev : lev-1;
     const std::array<Real,3>& dx = WarpX::CellSize(patch_level);
     Real dtsdx = dt/dx[0], dtsdy = dt/dx[1], dtsdz = dt/dx[2];
@@ -77,48 +249,58 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real dt)
         const Box& tby  = mfi.tilebox(By_nodal_flag);
         const Box& tbz  = mfi.tilebox(Bz_nodal_flag);
 
+#ifdef WARPX_RZ
         // xmin is only used by the picsar kernel with cylindrical geometry,
         // in which case it is actually rmin.
         const Real xmin = mfi.tilebox().smallEnd(0)*dx[0];
+#endif
 
-        if (do_nodal) {
-            auto const& Bxfab = Bx->array(mfi);
-            auto const& Byfab = By->array(mfi);
-            auto const& Bzfab = Bz->array(mfi);
-            auto const& Exfab = Ex->array(mfi);
-            auto const& Eyfab = Ey->array(mfi);
-            auto const& Ezfab = Ez->array(mfi);
-            amrex::ParallelFor(tbx,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_bx_nodal(j,k,l,Bxfab,Eyfab,Ezfab,dtsdy,dtsdz);
-            });
-            amrex::ParallelFor(tby,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_by_nodal(j,k,l,Byfab,Exfab,Ezfab,dtsdx,dtsdz);
-            });
-            amrex::ParallelFor(tbz,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_bz_nodal(j,k,l,Bzfab,Exfab,Eyfab,dtsdx,dtsdy);
-            });
-        } else {
-            // Call picsar routine for each tile
-            warpx_push_bvec(
-		      tbx.loVect(), tbx.hiVect(),
-		      tby.loVect(), tby.hiVect(),
-		      tbz.loVect(), tbz.hiVect(),
-		      BL_TO_FORTRAN_3D((*Ex)[mfi]),
-		      BL_TO_FORTRAN_3D((*Ey)[mfi]),
-		      BL_TO_FORTRAN_3D((*Ez)[mfi]),
-		      BL_TO_FORTRAN_3D((*Bx)[mfi]),
-		      BL_TO_FORTRAN_3D((*By)[mfi]),
-		      BL_TO_FORTRAN_3D((*Bz)[mfi]),
-                      &dtsdx, &dtsdy, &dtsdz,
-                      &xmin, &dx[0],
-		      &WarpX::maxwell_fdtd_solver_id);
-        }
+        forEachRegionBox(tbx, tby, tbz, mfi.validbox(), region,
+        [&] (const Box& tbx, const Box& tby, const Box& tbz)
+        {
+            if (do_nodal) {
+                auto const& Bxfab = Bx->array(mfi);
+                auto const& Byfab = By->array(mfi);
+                auto const& Bzfab = Bz->array(mfi);
+                auto const& Exfab = Ex->array(mfi);
+                auto const& Eyfab = Ey->array(mfi);
+                auto const& Ezfab = Ez->array(mfi);
+                amrex::ParallelFor(tbx,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_bx_nodal(j,k,l,Bxfab,Eyfab,Ezfab,dtsdy,dtsdz);
+                });
+                amrex::ParallelFor(tby,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_by_nodal(j,k,l,Byfab,Exfab,Ezfab,dtsdx,dtsdz);
+                });
+                amrex::ParallelFor(tbz,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_bz_nodal(j,k,l,Bzfab,Exfab,Eyfab,dtsdx,dtsdy);
+                });
+            } else {
+#ifdef WARPX_RZ
+                // Call picsar routine for each tile (cylindrical Yee solver)
+                warpx_push_bvec(
+                    tbx.loVect(), tbx.hiVect(),
+                    tby.loVect(), tby.hiVect(),
+                    tbz.loVect(), tbz.hiVect(),
+                    BL_TO_FORTRAN_3D((*Ex)[mfi]),
+                    BL_TO_FORTRAN_3D((*Ey)[mfi]),
+                    BL_TO_FORTRAN_3D((*Ez)[mfi]),
+                    BL_TO_FORTRAN_3D((*Bx)[mfi]),
+                    BL_TO_FORTRAN_3D((*By)[mfi]),
+                    BL_TO_FORTRAN_3D((*Bz)[mfi]),
+                    &dtsdx, &dtsdy, &dtsdz,
+                    &xmin, &dx[0],
+                    &WarpX::maxwell_fdtd_solver_id);
+#else
+                pushBFDTD(mfi, tbx, tby, tbz, {Ex,Ey,Ez}, {Bx,By,Bz}, dx, dt);
+#endif
+            }
+        });
 
         if (cost) {
             Box cbx = mfi.tilebox(IntVect{AMREX_D_DECL(0,0,0)});
@@ -133,16 +315,20 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real dt)
         }
     }
 
-    if (do_pml && pml[lev]->ok())
+    // The PML is pushed with the shell, after the guard cells are exchanged
+    if (do_pml && pml[lev]->ok() && region != FieldRegion::interior)
     {
         const auto& pml_B = (patch_type == PatchType::fine) ? pml[lev]->GetB_fp() : pml[lev]->GetB_cp();
         const auto& pml_E = (patch_type == PatchType::fine) ? pml[lev]->GetE_fp() : pml[lev]->GetE_cp();
+        const int pml_solver_type = pmlSolverType();
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
         for ( MFIter mfi(*pml_B[0], TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
+            Real wt = amrex::second();
+
             const Box& tbx  = mfi.tilebox(Bx_nodal_flag);
             const Box& tby  = mfi.tilebox(By_nodal_flag);
             const Box& tbz  = mfi.tilebox(Bz_nodal_flag);
@@ -158,34 +344,40 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real dt)
 			     BL_TO_FORTRAN_3D((*pml_B[1])[mfi]),
 			     BL_TO_FORTRAN_3D((*pml_B[2])[mfi]),
                              &dtsdx, &dtsdy, &dtsdz,
-			     &WarpX::maxwell_fdtd_solver_id);
+			     &pml_solver_type);
+
+            if (cost) {
+                pml[lev]->AddCost(patch_type, mfi.index(), amrex::second() - wt);
+            }
         }
     }
 }
 
 void
-WarpX::EvolveE (Real dt)
+WarpX::EvolveE (Real dt, FieldRegion region)
 {
     for (int lev = 0; lev <= finest_level; ++lev)
     {
-        EvolveE(lev, dt);
+        EvolveE(lev, dt, region);
     }
 }
 
 void
-WarpX::EvolveE (int lev, Real dt)
+WarpX::EvolveE (int lev, Real dt, FieldRegion region)
 {
     BL_PROFILE("WarpX::EvolveE()");
-    EvolveE(lev, PatchType::fine, dt);
+    EvolveE(lev, PatchType::fine, dt, region);
     if (lev > 0)
     {
-        EvolveE(lev, PatchType::coarse, dt);
+        EvolveE(lev, PatchType::coarse, dt, region);
     }
 }
 
 void
-WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real dt)
+WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real dt, FieldRegion region)
 {
+    MarkFieldsModified(lev);
+
     const Real mu_c2_dt = (PhysConst::mu0*PhysConst::c*PhysConst::c) * dt;
     const Real c2dt = (PhysConst::c*PhysConst::c) * dt;
 
@@ -236,68 +428,83 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real dt)
         const Box& tey  = mfi.tilebox(Ey_nodal_flag);
         const Box& tez  = mfi.tilebox(Ez_nodal_flag);
 
+#ifdef WARPX_RZ
         // xmin is only used by the picsar kernel with cylindrical geometry,
         // in which case it is actually rmin.
         const Real xmin = mfi.tilebox().smallEnd(0)*dx[0];
+#endif
 
-        if (do_nodal) {
-            auto const& Exfab = Ex->array(mfi);
-            auto const& Eyfab = Ey->array(mfi);
-            auto const& Ezfab = Ez->array(mfi);
-            auto const& Bxfab = Bx->array(mfi);
-            auto const& Byfab = By->array(mfi);
-            auto const& Bzfab = Bz->array(mfi);
-            auto const& jxfab = jx->array(mfi);
-            auto const& jyfab = jy->array(mfi);
-            auto const& jzfab = jz->array(mfi);
-            amrex::ParallelFor(tex,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_ex_nodal(j,k,l,Exfab,Byfab,Bzfab,jxfab,mu_c2_dt,dtsdy_c2,dtsdz_c2);
-            });
-            amrex::ParallelFor(tey,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_ey_nodal(j,k,l,Eyfab,Bxfab,Bzfab,jyfab,mu_c2_dt,dtsdx_c2,dtsdz_c2);
-            });
-            amrex::ParallelFor(tez,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_ez_nodal(j,k,l,Ezfab,Bxfab,Byfab,jzfab,mu_c2_dt,dtsdx_c2,dtsdy_c2);
-            });
-        } else {
-            // Call picsar routine for each tile
-            warpx_push_evec(
-		      tex.loVect(), tex.hiVect(),
-		      tey.loVect(), tey.hiVect(),
-		      tez.loVect(), tez.hiVect(),
-		      BL_TO_FORTRAN_3D((*Ex)[mfi]),
-		      BL_TO_FORTRAN_3D((*Ey)[mfi]),
-		      BL_TO_FORTRAN_3D((*Ez)[mfi]),
-		      BL_TO_FORTRAN_3D((*Bx)[mfi]),
-		      BL_TO_FORTRAN_3D((*By)[mfi]),
-		      BL_TO_FORTRAN_3D((*Bz)[mfi]),
-		      BL_TO_FORTRAN_3D((*jx)[mfi]),
-		      BL_TO_FORTRAN_3D((*jy)[mfi]),
-		      BL_TO_FORTRAN_3D((*jz)[mfi]),
-		      &mu_c2_dt,
-		      &dtsdx_c2, &dtsdy_c2, &dtsdz_c2,
-		      &xmin, &dx[0]);
-        }
-
-        if (F)
+        forEachRegionBox(tex, tey, tez, mfi.validbox(), region,
+        [&] (const Box& tex, const Box& tey, const Box& tez)
         {
-            warpx_push_evec_f(
-			  tex.loVect(), tex.hiVect(),
-			  tey.loVect(), tey.hiVect(),
-			  tez.loVect(), tez.hiVect(),
-			  BL_TO_FORTRAN_3D((*Ex)[mfi]),
-			  BL_TO_FORTRAN_3D((*Ey)[mfi]),
-			  BL_TO_FORTRAN_3D((*Ez)[mfi]),
-			  BL_TO_FORTRAN_3D((*F)[mfi]),
-                          &dtsdx_c2, &dtsdy_c2, &dtsdz_c2,
-			  &WarpX::maxwell_fdtd_solver_id);
-        }
+            if (do_nodal) {
+                auto const& Exfab = Ex->array(mfi);
+                auto const& Eyfab = Ey->array(mfi);
+                auto const& Ezfab = Ez->array(mfi);
+                auto const& Bxfab = Bx->array(mfi);
+                auto const& Byfab = By->array(mfi);
+                auto const& Bzfab = Bz->array(mfi);
+                auto const& jxfab = jx->array(mfi);
+                auto const& jyfab = jy->array(mfi);
+                auto const& jzfab = jz->array(mfi);
+                amrex::ParallelFor(tex,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_ex_nodal(j,k,l,Exfab,Byfab,Bzfab,jxfab,mu_c2_dt,dtsdy_c2,dtsdz_c2);
+                });
+                amrex::ParallelFor(tey,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_ey_nodal(j,k,l,Eyfab,Bxfab,Bzfab,jyfab,mu_c2_dt,dtsdx_c2,dtsdz_c2);
+                });
+                amrex::ParallelFor(tez,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_ez_nodal(j,k,l,Ezfab,Bxfab,Byfab,jzfab,mu_c2_dt,dtsdx_c2,dtsdy_c2);
+                });
+            } else {
+#ifdef WARPX_RZ
+                // Call picsar routine for each tile (cylindrical Yee solver)
+                warpx_push_evec(
+                    tex.loVect(), tex.hiVect(),
+                    tey.loVect(), tey.hiVect(),
+                    tez.loVect(), tez.hiVect(),
+                    BL_TO_FORTRAN_3D((*Ex)[mfi]),
+                    BL_TO_FORTRAN_3D((*Ey)[mfi]),
+                    BL_TO_FORTRAN_3D((*Ez)[mfi]),
+                    BL_TO_FORTRAN_3D((*Bx)[mfi]),
+                    BL_TO_FORTRAN_3D((*By)[mfi]),
+                    BL_TO_FORTRAN_3D((*Bz)[mfi]),
+                    BL_TO_FORTRAN_3D((*jx)[mfi]),
+                    BL_TO_FORTRAN_3D((*jy)[mfi]),
+                    BL_TO_FORTRAN_3D((*jz)[mfi]),
+                    &mu_c2_dt,
+                    &dtsdx_c2, &dtsdy_c2, &dtsdz_c2,
+                    &xmin, &dx[0]);
+#else
+                pushEFDTD(mfi, tex, tey, tez, {Ex,Ey,Ez}, {Bx,By,Bz}, {jx,jy,jz},
+                          mu_c2_dt, dx, c2dt);
+#endif
+            }
+
+            if (F)
+            {
+#ifdef WARPX_RZ
+                warpx_push_evec_f(
+                    tex.loVect(), tex.hiVect(),
+                    tey.loVect(), tey.hiVect(),
+                    tez.loVect(), tez.hiVect(),
+                    BL_TO_FORTRAN_3D((*Ex)[mfi]),
+                    BL_TO_FORTRAN_3D((*Ey)[mfi]),
+                    BL_TO_FORTRAN_3D((*Ez)[mfi]),
+                    BL_TO_FORTRAN_3D((*F)[mfi]),
+                    &dtsdx_c2, &dtsdy_c2, &dtsdz_c2,
+                    &WarpX::maxwell_fdtd_solver_id);
+#else
+                pushEFFDTD(mfi, tex, tey, tez, {Ex,Ey,Ez}, F, dx, c2dt);
+#endif
+            }
+        });
 
         if (cost) {
             Box cbx = mfi.tilebox(IntVect{AMREX_D_DECL(0,0,0)});
@@ -312,18 +519,22 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real dt)
         }
     }
 
-    if (do_pml && pml[lev]->ok())
+    // The PML is pushed with the shell, after the guard cells are exchanged
+    if (do_pml && pml[lev]->ok() && region != FieldRegion::interior)
     {
         if (F) pml[lev]->ExchangeF(patch_type, F);
 
         const auto& pml_B = (patch_type == PatchType::fine) ? pml[lev]->GetB_fp() : pml[lev]->GetB_cp();
         const auto& pml_E = (patch_type == PatchType::fine) ? pml[lev]->GetE_fp() : pml[lev]->GetE_cp();
         const auto& pml_F = (patch_type == PatchType::fine) ? pml[lev]->GetF_fp() : pml[lev]->GetF_cp();
+        const int pml_solver_type = pmlSolverType();
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
         for ( MFIter mfi(*pml_E[0], TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
+            Real wt = amrex::second();
+
             const Box& tex  = mfi.tilebox(Ex_nodal_flag);
             const Box& tey  = mfi.tilebox(Ey_nodal_flag);
             const Box& tez  = mfi.tilebox(Ez_nodal_flag);
@@ -351,10 +562,243 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real dt)
 				   BL_TO_FORTRAN_3D((*pml_E[2])[mfi]),
 				   BL_TO_FORTRAN_3D((*pml_F   )[mfi]),
                                    &dtsdx_c2, &dtsdy_c2, &dtsdz_c2,
-				   &WarpX::maxwell_fdtd_solver_id);
+				   &pml_solver_type);
+            }
+
+            if (cost) {
+                pml[lev]->AddCost(patch_type, mfi.index(), amrex::second() - wt);
+            }
+        }
+    }
+}
+
+void
+WarpX::EvolveBEB (Real dt)
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        EvolveBEB(lev, dt);
+    }
+}
+
+/* \brief Push B by dt/2, E by dt and B by dt/2 on level lev, and fill the
+ *  guard cells of E and B.
+ *
+ *  On level 0, the three pushes are done in a single sweep over each box,
+ *  plane by plane along the last dimension: at plane p, the first half push
+ *  of B is done at p, the push of E at p-1 and the second half push of B at
+ *  p-2, so that each plane of the fields is read from memory only once.
+ *  Instead of exchanging the guard cells between the pushes, the first half
+ *  push of B is done in 2 guard cells and the push of E in 1 guard cell,
+ *  from the E and B guard cells filled at the beginning of the step.
+ *  This is not possible on the refined levels, whose guard cells at the
+ *  coarse/fine boundary are not filled; they use the usual sequence.
+ */
+void
+WarpX::EvolveBEB (int lev, Real dt)
+{
+    BL_PROFILE("WarpX::EvolveBEB()");
+
+    if (lev > 0)
+    {
+        EvolveB(lev, 0.5*dt);
+        FillBoundaryB(lev);
+        EvolveE(lev, dt);
+        FillBoundaryE(lev);
+        EvolveB(lev, 0.5*dt);
+        FillBoundaryB(lev);
+        return;
+    }
+
+    MarkFieldsModified(lev);
+
+    const std::array<Real,3>& dx = WarpX::CellSize(lev);
+    const Real dtsdx = 0.5*dt/dx[0], dtsdy = 0.5*dt/dx[1], dtsdz = 0.5*dt/dx[2];
+    const Real mu_c2_dt = (PhysConst::mu0*PhysConst::c*PhysConst::c) * dt;
+    const Real c2dt = (PhysConst::c*PhysConst::c) * dt;
+    const Real dtsdx_c2 = c2dt/dx[0], dtsdy_c2 = c2dt/dx[1], dtsdz_c2 = c2dt/dx[2];
+    // Temporal blocking is only used with the Yee (or nodal) solver
+    const YeeSolver solver_b(dx, 0.5*dt);
+    const YeeSolver solver_e(dx, c2dt);
+
+    MultiFab* Ex = Efield_fp[lev][0].get();
+    MultiFab* Ey = Efield_fp[lev][1].get();
+    MultiFab* Ez = Efield_fp[lev][2].get();
+    MultiFab* Bx = Bfield_fp[lev][0].get();
+    MultiFab* By = Bfield_fp[lev][1].get();
+    MultiFab* Bz = Bfield_fp[lev][2].get();
+    MultiFab* jx = current_fp[lev][0].get();
+    MultiFab* jy = current_fp[lev][1].get();
+    MultiFab* jz = current_fp[lev][2].get();
+
+    AMREX_ALWAYS_ASSERT(Ex->nGrowVect().min() >= 3 && Bx->nGrowVect().min() >= 3);
+
+    const auto& period = Geom(lev).periodicity();
+    {
+        // E is pushed in 1 guard cell, where SumBoundary left partial sums of the current
+        Vector<MultiFab*> mf{jx,jy,jz};
+        guard_cell_exchange.FillBoundary(mf, period);
+    }
+
+    // The guard cells outside of the domain are not pushed (as with EvolveB/EvolveE),
+    // except in the periodic directions.
+    Box domain = Geom(lev).Domain();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (Geom(lev).isPeriodic(idim)) domain.grow(idim, Ex->nGrowVect()[idim]);
+    }
+    const std::array<IntVect,3> Bflag {Bx_nodal_flag, By_nodal_flag, Bz_nodal_flag};
+    const std::array<IntVect,3> Eflag {Ex_nodal_flag, Ey_nodal_flag, Ez_nodal_flag};
+
+    constexpr int sweep_dir = AMREX_SPACEDIM-1;
+    // Slice of bx at index p along the sweep direction (empty if p is outside of bx)
+    auto plane = [] (const Box& bx, int p) -> Box
+    {
+        Box b(bx);
+        b.setSmall(sweep_dir, p);
+        b.setBig(sweep_dir, (p < bx.smallEnd(sweep_dir) || p > bx.bigEnd(sweep_dir)) ? p-1 : p);
+        return b;
+    };
+
+    MultiFab* cost = costs[lev].get();
+
+    // No tiling: each thread sweeps whole boxes, since the pushes are done in place
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for ( MFIter mfi(*Bx); mfi.isValid(); ++mfi )
+    {
+        Real wt = amrex::second();
+
+        const Box& vbx = mfi.validbox();
+
+        // Regions of the first half push of B, of the push of E and
+        // of the second half push of B
+        std::array<Box,3> b1box, ebox, b2box;
+        int plo = vbx.bigEnd(sweep_dir);
+        int phi = vbx.smallEnd(sweep_dir);
+        for (int i = 0; i < 3; ++i) {
+            b1box[i] = amrex::convert(amrex::grow(vbx,2), Bflag[i]) & amrex::convert(domain, Bflag[i]);
+            ebox[i]  = amrex::convert(amrex::grow(vbx,1), Eflag[i]) & amrex::convert(domain, Eflag[i]);
+            b2box[i] = amrex::convert(vbx, Bflag[i]);
+            plo = std::min(plo, b1box[i].smallEnd(sweep_dir));
+            phi = std::max(phi, b1box[i].bigEnd(sweep_dir));
+        }
+
+        auto const& Bxfab = Bx->array(mfi);
+        auto const& Byfab = By->array(mfi);
+        auto const& Bzfab = Bz->array(mfi);
+        auto const& Exfab = Ex->array(mfi);
+        auto const& Eyfab = Ey->array(mfi);
+        auto const& Ezfab = Ez->array(mfi);
+        auto const& jxfab = jx->array(mfi);
+        auto const& jyfab = jy->array(mfi);
+        auto const& jzfab = jz->array(mfi);
+
+        auto push_b = [&] (const Box& tbx, const Box& tby, const Box& tbz)
+        {
+            if (do_nodal) {
+                amrex::ParallelFor(tbx,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_bx_nodal(j,k,l,Bxfab,Eyfab,Ezfab,dtsdy,dtsdz);
+                });
+                amrex::ParallelFor(tby,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_by_nodal(j,k,l,Byfab,Exfab,Ezfab,dtsdx,dtsdz);
+                });
+                amrex::ParallelFor(tbz,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_bz_nodal(j,k,l,Bzfab,Exfab,Eyfab,dtsdx,dtsdy);
+                });
+            } else {
+                pushB(mfi, tbx, tby, tbz, {Ex,Ey,Ez}, {Bx,By,Bz}, solver_b);
             }
+        };
+
+        auto push_e = [&] (const Box& tex, const Box& tey, const Box& tez)
+        {
+            if (do_nodal) {
+                amrex::ParallelFor(tex,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_ex_nodal(j,k,l,Exfab,Byfab,Bzfab,jxfab,mu_c2_dt,dtsdy_c2,dtsdz_c2);
+                });
+                amrex::ParallelFor(tey,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_ey_nodal(j,k,l,Eyfab,Bxfab,Bzfab,jyfab,mu_c2_dt,dtsdx_c2,dtsdz_c2);
+                });
+                amrex::ParallelFor(tez,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_ez_nodal(j,k,l,Ezfab,Bxfab,Byfab,jzfab,mu_c2_dt,dtsdx_c2,dtsdy_c2);
+                });
+            } else {
+                pushE(mfi, tex, tey, tez, {Ex,Ey,Ez}, {Bx,By,Bz}, {jx,jy,jz},
+                      mu_c2_dt, solver_e);
+            }
+        };
+
+        // The stencils reach one plane on each side: at plane p, B^{n+1/2} is
+        // computed from E^{n} at p-1, p and p+1 (not pushed yet), E^{n+1} at p-1
+        // from B^{n+1/2} at p-2, p-1 and p, and B^{n+1} at p-2 from E^{n+1} at
+        // p-3, p-2 and p-1.
+        for (int p = plo; p <= phi+2; ++p)
+        {
+            push_b(plane(b1box[0],p), plane(b1box[1],p), plane(b1box[2],p));
+            push_e(plane(ebox[0],p-1), plane(ebox[1],p-1), plane(ebox[2],p-1));
+            push_b(plane(b2box[0],p-2), plane(b2box[1],p-2), plane(b2box[2],p-2));
+        }
+
+        if (cost) {
+            const Box& cbx = mfi.tilebox(IntVect{AMREX_D_DECL(0,0,0)});
+            wt = (amrex::second() - wt) / cbx.d_numPts();
+            auto costfab = cost->array(mfi);
+            amrex::ParallelFor(cbx,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                costfab(i,j,k) += wt;
+            });
         }
     }
+
+    // Single exchange of the guard cells of E and B
+    Vector<MultiFab*> mf{Ex,Ey,Ez,Bx,By,Bz};
+    guard_cell_exchange.FillBoundary(mf, period);
+}
+
+/* \brief Same sequence of pushes as in OneStep_nosub, but the guard cells
+ *  are exchanged with non-blocking communications: while the guard cells of
+ *  B (resp. E) are exchanged, the interior of the boxes is pushed for E
+ *  (resp. B), and the shell that needs the guard cells is pushed after the
+ *  exchange is finished.
+ */
+void
+WarpX::EvolveFieldsOverlapComm (Real dt)
+{
+    BL_PROFILE("WarpX::EvolveFieldsOverlapComm()");
+
+    EvolveF(0.5*dt, DtType::FirstHalf);
+    FillBoundaryF_nowait();
+    EvolveB(0.5*dt); // We now have B^{n+1/2}; this does not use F
+    FillBoundaryB_nowait();
+    EvolveE(dt, FieldRegion::interior);
+    FillBoundaryF_finish();
+    FillBoundaryB_finish();
+    EvolveE(dt, FieldRegion::shell); // We now have E^{n+1}
+    FillBoundaryE_nowait();
+    EvolveB(0.5*dt, FieldRegion::interior);
+    FillBoundaryE_finish();
+    EvolveF(0.5*dt, DtType::SecondHalf);
+    EvolveB(0.5*dt, FieldRegion::shell); // We now have B^{n+1}
+    if (do_pml) {
+        DampPML();
+        FillBoundaryEB();
+    } else {
+        FillBoundaryB();
+    }
 }
 
 void
@@ -425,6 +869,8 @@ WarpX::EvolveF (int lev, PatchType patch_type, Real dt, DtType dt_type)
 #endif
         for ( MFIter mfi(*pml_F, TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
+            Real wt = amrex::second();
+
             const Box& bx = mfi.tilebox();
             WRPX_PUSH_PML_F(bx.loVect(), bx.hiVect(),
 			  BL_TO_FORTRAN_ANYD((*pml_F   )[mfi]),
@@ -432,6 +878,10 @@ WarpX::EvolveF (int lev, PatchType patch_type, Real dt, DtType dt_type)
 			  BL_TO_FORTRAN_ANYD((*pml_E[1])[mfi]),
 			  BL_TO_FORTRAN_ANYD((*pml_E[2])[mfi]),
 			  &dtsdx[0], &dtsdx[1], &dtsdx[2]);
+
+            if (costs[lev]) {
+                pml[lev]->AddCost(patch_type, mfi.index(), amrex::second() - wt);
+            }
         }
     }
 }
@@ -33,6 +33,8 @@ WarpX::InitData ()
 	PostRestart();
     }
 
+    MarkFieldsModified();
+
     ComputePMLFactors();
 
     if (WarpX::use_fdtd_nci_corr) {
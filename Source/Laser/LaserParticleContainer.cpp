@@ -8,6 +8,7 @@
 #include <WarpXConst.H>
 #include <WarpX_f.H>
 #include <MultiParticleContainer.H>
+#include <ScratchArena.H>
 
 using namespace amrex;
 
@@ -342,6 +343,9 @@ LaserParticleContainer::Evolve (int lev,
         {
             Real wt = amrex::second();
 
+            // Temporaries allocated for this tile (e.g. in DepositCurrent)
+            ScratchArena::ThreadArena().reset();
+
             const Box& box = pti.validbox();
 
             auto& attribs = pti.GetAttribs();
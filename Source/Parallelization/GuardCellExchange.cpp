@@ -0,0 +1,351 @@
+#include <algorithm>
+
+#include <AMReX_BLProfiler.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <GuardCellExchange.H>
+
+using namespace amrex;
+
+namespace
+{
+    // Order of the tags in the messages; the same on the sending and receiving ranks
+    bool tagLess (int mf1, int dst1, int src1, const Box& b1,
+                  int mf2, int dst2, int src2, const Box& b2)
+    {
+        if (mf1 != mf2) return mf1 < mf2;
+        if (dst1 != dst2) return dst1 < dst2;
+        if (src1 != src2) return src1 < src2;
+        if (b1.smallEnd() != b2.smallEnd()) return b1.smallEnd().lexLT(b2.smallEnd());
+        return b1.bigEnd().lexLT(b2.bigEnd());
+    }
+}
+
+void
+GuardCellExchange::FillBoundary (const Vector<MultiFab*>& mf, const Periodicity& period)
+{
+    FillBoundary(mf, Vector<Periodicity>(mf.size(), period));
+}
+
+void
+GuardCellExchange::FillBoundary (const Vector<MultiFab*>& mf, const Vector<Periodicity>& period)
+{
+    FillBoundary_nowait(mf, period);
+    FillBoundary_finish(mf);
+}
+
+void
+GuardCellExchange::FillBoundary_nowait (const Vector<MultiFab*>& mf, const Periodicity& period)
+{
+    FillBoundary_nowait(mf, Vector<Periodicity>(mf.size(), period));
+}
+
+void
+GuardCellExchange::FillBoundary_nowait (const Vector<MultiFab*>& mf,
+                                        const Vector<Periodicity>& period)
+{
+    BL_PROFILE("GuardCellExchange::FillBoundary_nowait()");
+
+#ifdef AMREX_USE_GPU
+    // The messages are packed on the host: use the FillBoundary of each MultiFab
+    for (int m = 0; m < static_cast<int>(mf.size()); ++m) {
+        mf[m]->FillBoundary_nowait(period[m]);
+    }
+#else
+    Plan& plan = getPlan(mf, period);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!plan.in_flight,
+        "GuardCellExchange: exchange already in flight for these MultiFabs");
+    startExchange(plan, mf);
+#endif
+}
+
+void
+GuardCellExchange::startExchange (Plan& plan, const Vector<MultiFab*>& mf)
+{
+    plan.in_flight = true;
+
+#ifdef BL_USE_MPI
+    // As in FabArray::FillBoundary, all the ranks take a new sequence number,
+    // even those that have nothing to send or receive, so that the tags of
+    // later messages stay the same on all ranks
+    const int tag = (ParallelDescriptor::NProcs() > 1) ? ParallelDescriptor::SeqNum() : 0;
+    if (!plan.send_tags.empty() || !plan.recv_tags.empty())
+    {
+        MPI_Comm comm = ParallelDescriptor::Communicator();
+        const MPI_Datatype mpi_real = ParallelDescriptor::Mpi_typemap<Real>::type();
+
+        plan.recv_buf.resize(plan.recv_tags.size());
+        plan.recv_reqs.resize(plan.recv_tags.size());
+        int k = 0;
+        for (const auto& kv : plan.recv_size) {
+            plan.recv_buf[k].resize(kv.second);
+            MPI_Irecv(plan.recv_buf[k].data(), kv.second, mpi_real, kv.first,
+                      tag, comm, &plan.recv_reqs[k]);
+            ++k;
+        }
+
+        plan.send_buf.resize(plan.send_tags.size());
+        plan.send_reqs.resize(plan.send_tags.size());
+        k = 0;
+        for (const auto& kv : plan.send_tags) {
+            const int rank = kv.first;
+            plan.send_buf[k].resize(plan.send_size[rank]);
+            Real* p = plan.send_buf[k].data();
+            for (const CopyTag& t : kv.second) {
+                const int ncomp = mf[t.mf]->nComp();
+                (*mf[t.mf])[t.src].copyToMem(t.sbox, 0, ncomp, p);
+                p += t.sbox.numPts()*ncomp;
+            }
+            MPI_Isend(plan.send_buf[k].data(), plan.send_size[rank], mpi_real, rank,
+                      tag, comm, &plan.send_reqs[k]);
+            ++k;
+        }
+    }
+#endif
+
+    const int nlocal = plan.local_tags.size();
+#ifdef _OPENMP
+#pragma omp parallel for if (plan.local_threadsafe)
+#endif
+    for (int k = 0; k < nlocal; ++k)
+    {
+        const CopyTag& t = plan.local_tags[k];
+        const int ncomp = mf[t.mf]->nComp();
+        (*mf[t.mf])[t.dst].copy((*mf[t.mf])[t.src], t.sbox, 0, t.dbox, 0, ncomp);
+    }
+}
+
+void
+GuardCellExchange::FillBoundary_finish (const Vector<MultiFab*>& mf)
+{
+    BL_PROFILE("GuardCellExchange::FillBoundary_finish()");
+
+#ifdef AMREX_USE_GPU
+    for (auto m : mf) {
+        m->FillBoundary_finish();
+    }
+#else
+    const auto it = m_plans.find(makeKey(mf, nullptr, nullptr));
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(it != m_plans.end() && it->second->in_flight,
+        "GuardCellExchange: FillBoundary_finish without FillBoundary_nowait");
+    finishExchange(*it->second, mf);
+#endif
+}
+
+void
+GuardCellExchange::finishExchange (Plan& plan, const Vector<MultiFab*>& mf)
+{
+#ifdef BL_USE_MPI
+    if (!plan.recv_reqs.empty()) {
+        Vector<MPI_Status> stats(plan.recv_reqs.size());
+        MPI_Waitall(plan.recv_reqs.size(), plan.recv_reqs.data(), stats.data());
+    }
+
+    int k = 0;
+    for (const auto& kv : plan.recv_tags) {
+        const Real* p = plan.recv_buf[k].data();
+        for (const CopyTag& t : kv.second) {
+            const int ncomp = mf[t.mf]->nComp();
+            (*mf[t.mf])[t.dst].copyFromMem(t.dbox, 0, ncomp, p);
+            p += t.dbox.numPts()*ncomp;
+        }
+        ++k;
+    }
+
+    if (!plan.send_reqs.empty()) {
+        Vector<MPI_Status> stats(plan.send_reqs.size());
+        MPI_Waitall(plan.send_reqs.size(), plan.send_reqs.data(), stats.data());
+    }
+    plan.send_reqs.clear();
+    plan.recv_reqs.clear();
+#endif
+
+    plan.in_flight = false;
+}
+
+void
+GuardCellExchange::FillBoundary (const Vector<MultiFab*>& mf, const Periodicity& period,
+                                 const IntVect& nglo, const IntVect& nghi)
+{
+    BL_PROFILE("GuardCellExchange::FillBoundary(nglo,nghi)");
+
+#ifdef AMREX_USE_GPU
+    // All the guard cells are filled
+    for (auto m : mf) {
+        m->FillBoundary(period);
+    }
+#else
+    Plan& plan = getPlan(mf, Vector<Periodicity>(mf.size(), period), &nglo, &nghi);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!plan.in_flight,
+        "GuardCellExchange: exchange already in flight for these MultiFabs");
+    startExchange(plan, mf);
+    finishExchange(plan, mf);
+#endif
+}
+
+GuardCellExchange::PlanKey
+GuardCellExchange::makeKey (const Vector<MultiFab*>& mf, const IntVect* nglo, const IntVect* nghi)
+{
+    PlanKey key;
+    key.first.assign(mf.begin(), mf.end());
+    if (nglo) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            key.second.push_back((*nglo)[idim]);
+            key.second.push_back((*nghi)[idim]);
+        }
+    }
+    return key;
+}
+
+GuardCellExchange::Plan&
+GuardCellExchange::getPlan (const Vector<MultiFab*>& mf, const Vector<Periodicity>& period,
+                            const IntVect* nglo, const IntVect* nghi)
+{
+    auto& plan = m_plans[makeKey(mf, nglo, nghi)];
+    if (plan == nullptr || !isValid(*plan, mf, period))
+    {
+        AMREX_ALWAYS_ASSERT(plan == nullptr || !plan->in_flight);
+        plan.reset(new Plan());
+        if (nglo) {
+            plan->restricted = true;
+            plan->nglo = *nglo;
+            plan->nghi = *nghi;
+        }
+        buildPlan(*plan, mf, period);
+    }
+    return *plan;
+}
+
+bool
+GuardCellExchange::isValid (const Plan& plan, const Vector<MultiFab*>& mf,
+                            const Vector<Periodicity>& period)
+{
+    if (plan.ba.size() != mf.size()) return false;
+    for (int m = 0; m < static_cast<int>(mf.size()); ++m) {
+        if (!(plan.ba[m] == mf[m]->boxArray()) ||
+            !(plan.dm[m] == mf[m]->DistributionMap()) ||
+            plan.ng[m] != mf[m]->nGrowVect() ||
+            !(plan.period[m] == period[m])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* \brief Same pattern as FabArray::FillBoundary: the guard cells (and only
+ *  the guard cells) of each box are filled with the valid cells of the boxes
+ *  that overlap them, possibly shifted by a periodic shift.
+ */
+void
+GuardCellExchange::buildPlan (Plan& plan, const Vector<MultiFab*>& mf,
+                              const Vector<Periodicity>& period)
+{
+    BL_PROFILE("GuardCellExchange::buildPlan()");
+
+    const int myproc = ParallelDescriptor::MyProc();
+    std::vector<std::pair<int,Box> > isects;
+
+    for (int m = 0; m < static_cast<int>(mf.size()); ++m)
+    {
+        const BoxArray& ba = mf[m]->boxArray();
+        const DistributionMapping& dm = mf[m]->DistributionMap();
+        const IntVect& ng = mf[m]->nGrowVect();
+        const std::vector<IntVect>& shifts = period[m].shiftIntVect();
+
+        plan.ba.push_back(ba);
+        plan.dm.push_back(dm);
+        plan.ng.push_back(ng);
+        plan.period.push_back(period[m]);
+
+        // Box i and the guard cells that are filled
+        auto region = [&] (int i) -> Box {
+            Box b = amrex::grow(ba[i], ng);
+            if (plan.restricted) {
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    b.growLo(idim, std::min(plan.nglo[idim], ng[idim]) - ng[idim]);
+                    b.growHi(idim, std::min(plan.nghi[idim], ng[idim]) - ng[idim]);
+                }
+            }
+            return b;
+        };
+
+        for (int i = 0; i < ba.size(); ++i)
+        {
+            if (dm[i] != myproc) continue;
+            // Guard cells of the local box i, filled by the box j
+            const Box& gbx = region(i);
+            for (const IntVect& s : shifts)
+            {
+                ba.intersections(gbx + s, isects);
+                for (const auto& is : isects)
+                {
+                    const int j = is.first;
+                    if (j == i && s == IntVect::TheZeroVector()) continue;
+                    for (const Box& b : amrex::boxDiff(is.second - s, ba[i]))
+                    {
+                        const CopyTag tag {m, j, i, b + s, b};
+                        if (dm[j] == myproc) {
+                            plan.local_tags.push_back(tag);
+                        } else {
+                            plan.recv_tags[dm[j]].push_back(tag);
+                        }
+                    }
+                }
+            }
+        }
+
+        for (int j = 0; j < ba.size(); ++j)
+        {
+            if (dm[j] != myproc) continue;
+            // Guard cells of the box i of another rank, filled by the local box j
+            for (const IntVect& s : shifts)
+            {
+                const Box& sbx = ba[j] - s;
+                ba.intersections(amrex::grow(sbx, ng), isects);
+                for (const auto& is : isects)
+                {
+                    const int i = is.first;
+                    if (dm[i] == myproc) continue;
+                    const Box& dbx = region(i) & sbx;
+                    if (!dbx.ok()) continue;
+                    for (const Box& b : amrex::boxDiff(dbx, ba[i]))
+                    {
+                        plan.send_tags[dm[i]].push_back(CopyTag {m, j, i, b + s, b});
+                    }
+                }
+            }
+        }
+    }
+
+    auto tag_less = [] (const CopyTag& a, const CopyTag& b) {
+        return tagLess(a.mf, a.dst, a.src, a.dbox, b.mf, b.dst, b.src, b.dbox);
+    };
+    for (auto& kv : plan.send_tags) {
+        std::sort(kv.second.begin(), kv.second.end(), tag_less);
+        long n = 0;
+        for (const CopyTag& t : kv.second) n += t.dbox.numPts()*mf[t.mf]->nComp();
+        plan.send_size[kv.first] = n;
+    }
+    for (auto& kv : plan.recv_tags) {
+        std::sort(kv.second.begin(), kv.second.end(), tag_less);
+        long n = 0;
+        for (const CopyTag& t : kv.second) n += t.dbox.numPts()*mf[t.mf]->nComp();
+        plan.recv_size[kv.first] = n;
+    }
+
+    // The local copies can be done in parallel unless two of them write to
+    // the same cells (e.g. guard cells of nodal data filled by two boxes)
+    std::sort(plan.local_tags.begin(), plan.local_tags.end(), tag_less);
+    const int nlocal = plan.local_tags.size();
+    for (int a = 0; a < nlocal && plan.local_threadsafe; ++a) {
+        const CopyTag& ta = plan.local_tags[a];
+        for (int b = a+1; b < nlocal; ++b) {
+            const CopyTag& tb = plan.local_tags[b];
+            if (tb.mf != ta.mf || tb.dst != ta.dst) break;
+            if (ta.dbox.intersects(tb.dbox)) {
+                plan.local_threadsafe = false;
+                break;
+            }
+        }
+    }
+}
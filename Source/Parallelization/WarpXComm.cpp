@@ -1,7 +1,6 @@
 #include <WarpX.H>
 #include <WarpX_f.H>
-
-#include <AMReX_FillPatchUtil_F.H>
+#include <WarpXComm_K.H>
 
 #include <algorithm>
 #include <cstdlib>
@@ -11,6 +10,7 @@ using namespace amrex;
 void
 WarpX::ExchangeWithPmlB (int lev)
 {
+    MarkFieldsModified(lev);
     if (do_pml && pml[lev]->ok()) {
         pml[lev]->ExchangeB({ Bfield_fp[lev][0].get(),
                               Bfield_fp[lev][1].get(),
@@ -24,6 +24,7 @@ WarpX::ExchangeWithPmlB (int lev)
 void
 WarpX::ExchangeWithPmlE (int lev)
 {
+    MarkFieldsModified(lev);
     if (do_pml && pml[lev]->ok()) {
         pml[lev]->ExchangeE({ Efield_fp[lev][0].get(),
                               Efield_fp[lev][1].get(),
@@ -43,165 +44,180 @@ WarpX::ExchangeWithPmlF (int lev)
     }
 }
 
+void
+WarpX::MarkFieldsModified ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        MarkFieldsModified(lev);
+    }
+}
+
 void
 WarpX::UpdateAuxilaryData ()
 {
     BL_PROFILE("UpdateAuxilaryData()");
 
-    const int use_limiter = 0;
-
     for (int lev = 1; lev <= finest_level; ++lev)
     {
+        // aux(lev) only depends on the fields of the levels 0 to lev
+        const Vector<long> version(field_version.begin(), field_version.begin()+lev+1);
+#ifndef WARPX_USE_PY
+        // (With Python, the fields may have been modified by the callbacks)
+        if (version == aux_version[lev]) continue;
+#endif
+        aux_version[lev] = version;
+
         const auto& crse_period = Geom(lev-1).periodicity();
         const IntVect& ng = Bfield_cp[lev][0]->nGrowVect();
-        const DistributionMapping& dm = Bfield_cp[lev][0]->DistributionMap();
 
-        // B field
+        // Copy aux(lev-1) to the coarse patch grids, in Bfield_cax/Efield_cax
+        // (needed by the field gather buffers) or in the persistent
+        // Bfield_aux_crse/Efield_aux_crse. The cells of these MultiFabs that
+        // are not covered by aux(lev-1) keep the value 0 set at allocation,
+        // and the communication pattern of ParallelCopy is cached by AMReX
+        // (for the BoxArray and DistributionMapping of the coarse patch).
+        std::array<MultiFab*,3> Bcrse, Ecrse;
+        for (int idim = 0; idim < 3; ++idim)
         {
-            MultiFab dBx(Bfield_cp[lev][0]->boxArray(), dm, 1, ng);
-            MultiFab dBy(Bfield_cp[lev][1]->boxArray(), dm, 1, ng);
-            MultiFab dBz(Bfield_cp[lev][2]->boxArray(), dm, 1, ng);
-            dBx.setVal(0.0);
-            dBy.setVal(0.0);
-            dBz.setVal(0.0);
-            dBx.ParallelCopy(*Bfield_aux[lev-1][0], 0, 0, 1, ng, ng, crse_period);
-            dBy.ParallelCopy(*Bfield_aux[lev-1][1], 0, 0, 1, ng, ng, crse_period);
-            dBz.ParallelCopy(*Bfield_aux[lev-1][2], 0, 0, 1, ng, ng, crse_period);
-            if (Bfield_cax[lev][0])
-            {
-                MultiFab::Copy(*Bfield_cax[lev][0], dBx, 0, 0, 1, ng);
-                MultiFab::Copy(*Bfield_cax[lev][1], dBy, 0, 0, 1, ng);
-                MultiFab::Copy(*Bfield_cax[lev][2], dBz, 0, 0, 1, ng);
-            }
-            MultiFab::Subtract(dBx, *Bfield_cp[lev][0], 0, 0, 1, ng);
-            MultiFab::Subtract(dBy, *Bfield_cp[lev][1], 0, 0, 1, ng);
-            MultiFab::Subtract(dBz, *Bfield_cp[lev][2], 0, 0, 1, ng);
+            Bcrse[idim] = (Bfield_cax[lev][idim]) ? Bfield_cax[lev][idim].get()
+                                                  : Bfield_aux_crse[lev][idim].get();
+            Ecrse[idim] = (Efield_cax[lev][idim]) ? Efield_cax[lev][idim].get()
+                                                  : Efield_aux_crse[lev][idim].get();
+            Bcrse[idim]->ParallelCopy(*Bfield_aux[lev-1][idim], 0, 0, 1, ng, ng, crse_period);
+            Ecrse[idim]->ParallelCopy(*Efield_aux[lev-1][idim], 0, 0, 1, ng, ng, crse_period);
+        }
 
-            const Real* dx = Geom(lev-1).CellSize();
-            const int ref_ratio = refRatio(lev-1)[0];
+        const std::array<Real,3>& dx = WarpX::CellSize(lev-1);
+        const int rr = refRatio(lev-1)[0];
+        const IntVect Bx_nodal = Bx_nodal_flag, By_nodal = By_nodal_flag, Bz_nodal = Bz_nodal_flag;
+        const IntVect Ex_nodal = Ex_nodal_flag, Ey_nodal = Ey_nodal_flag, Ez_nodal = Ez_nodal_flag;
+        const bool nodal = do_nodal;
+
+        // aux = fp + I(crse - cp), in the valid and guard cells of aux
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
+        for (MFIter mfi(*Bfield_aux[lev][0]); mfi.isValid(); ++mfi)
+        {
+            // B field
             {
-                std::array<FArrayBox,3> bfab;
-                for (MFIter mfi(*Bfield_aux[lev][0]); mfi.isValid(); ++mfi)
+                auto const& bx_aux = Bfield_aux[lev][0]->array(mfi);
+                auto const& by_aux = Bfield_aux[lev][1]->array(mfi);
+                auto const& bz_aux = Bfield_aux[lev][2]->array(mfi);
+                auto const& bx_fp = Bfield_fp[lev][0]->array(mfi);
+                auto const& by_fp = Bfield_fp[lev][1]->array(mfi);
+                auto const& bz_fp = Bfield_fp[lev][2]->array(mfi);
+                auto const& bx_cp = Bfield_cp[lev][0]->array(mfi);
+                auto const& by_cp = Bfield_cp[lev][1]->array(mfi);
+                auto const& bz_cp = Bfield_cp[lev][2]->array(mfi);
+                auto const& bx_c = Bcrse[0]->array(mfi);
+                auto const& by_c = Bcrse[1]->array(mfi);
+                auto const& bz_c = Bcrse[2]->array(mfi);
+
+                const Box& tbx = (*Bfield_aux[lev][0])[mfi].box();
+                const Box& tby = (*Bfield_aux[lev][1])[mfi].box();
+                const Box& tbz = (*Bfield_aux[lev][2])[mfi].box();
+
+                if (nodal)
+                {
+                    amrex::ParallelFor(tbx,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        bx_aux(j,k,l) = bx_fp(j,k,l) + warpx_interp_linear(j,k,l,bx_c,bx_cp,Bx_nodal,rr);
+                    });
+                    amrex::ParallelFor(tby,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        by_aux(j,k,l) = by_fp(j,k,l) + warpx_interp_linear(j,k,l,by_c,by_cp,By_nodal,rr);
+                    });
+                    amrex::ParallelFor(tbz,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        bz_aux(j,k,l) = bz_fp(j,k,l) + warpx_interp_linear(j,k,l,bz_c,bz_cp,Bz_nodal,rr);
+                    });
+                }
+                else
                 {
-                    Box ccbx = mfi.fabbox();
-                    ccbx.enclosedCells();
-                    ccbx.coarsen(ref_ratio).refine(ref_ratio); // so that ccbx is coarsenable
-
-                    const FArrayBox& cxfab = dBx[mfi];
-                    const FArrayBox& cyfab = dBy[mfi];
-                    const FArrayBox& czfab = dBz[mfi];
-                    bfab[0].resize(amrex::convert(ccbx,Bx_nodal_flag));
-                    bfab[1].resize(amrex::convert(ccbx,By_nodal_flag));
-                    bfab[2].resize(amrex::convert(ccbx,Bz_nodal_flag));
-
 #if (AMREX_SPACEDIM == 3)
-                    amrex_interp_div_free_bfield(ccbx.loVect(), ccbx.hiVect(),
-                                                 BL_TO_FORTRAN_ANYD(bfab[0]),
-                                                 BL_TO_FORTRAN_ANYD(bfab[1]),
-                                                 BL_TO_FORTRAN_ANYD(bfab[2]),
-                                                 BL_TO_FORTRAN_ANYD(cxfab),
-                                                 BL_TO_FORTRAN_ANYD(cyfab),
-                                                 BL_TO_FORTRAN_ANYD(czfab),
-                                                 dx, &ref_ratio,&use_limiter);
+                    const Real dxc = dx[0], dyc = dx[1], dzc = dx[2];
+                    amrex::ParallelFor(tbx,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        bx_aux(j,k,l) = bx_fp(j,k,l)
+                            + warpx_interp_div_free_bx(j,k,l,bx_c,bx_cp,by_c,by_cp,bz_c,bz_cp,
+                                                       dxc,dyc,dzc,rr);
+                    });
+                    amrex::ParallelFor(tby,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        by_aux(j,k,l) = by_fp(j,k,l)
+                            + warpx_interp_div_free_by(j,k,l,bx_c,bx_cp,by_c,by_cp,bz_c,bz_cp,
+                                                       dxc,dyc,dzc,rr);
+                    });
+                    amrex::ParallelFor(tbz,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        bz_aux(j,k,l) = bz_fp(j,k,l)
+                            + warpx_interp_div_free_bz(j,k,l,bx_c,bx_cp,by_c,by_cp,bz_c,bz_cp,
+                                                       dxc,dyc,dzc,rr);
+                    });
 #else
-                    amrex_interp_div_free_bfield(ccbx.loVect(), ccbx.hiVect(),
-                                                 BL_TO_FORTRAN_ANYD(bfab[0]),
-                                                 BL_TO_FORTRAN_ANYD(bfab[2]),
-                                                 BL_TO_FORTRAN_ANYD(cxfab),
-                                                 BL_TO_FORTRAN_ANYD(czfab),
-                                                 dx, &ref_ratio,&use_limiter);
-                    amrex_interp_cc_bfield(ccbx.loVect(), ccbx.hiVect(),
-                                           BL_TO_FORTRAN_ANYD(bfab[1]),
-                                           BL_TO_FORTRAN_ANYD(cyfab),
-                                           &ref_ratio,&use_limiter);
-#endif
-
-                    for (int idim = 0; idim < 3; ++idim)
+                    const Real dxc = dx[0], dzc = dx[2];
+                    amrex::ParallelFor(tbx,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        bx_aux(j,k,l) = bx_fp(j,k,l)
+                            + warpx_interp_div_free_bx(j,k,l,bx_c,bx_cp,bz_c,bz_cp,dxc,dzc,rr);
+                    });
+                    amrex::ParallelFor(tby,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        by_aux(j,k,l) = by_fp(j,k,l) + warpx_interp_cc_by(j,k,l,by_c,by_cp,rr);
+                    });
+                    amrex::ParallelFor(tbz,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
                     {
-                        FArrayBox& aux = (*Bfield_aux[lev][idim])[mfi];
-                        FArrayBox& fp  =  (*Bfield_fp[lev][idim])[mfi];
-                        const Box& bx = aux.box();
-                        aux.copy(fp, bx, 0, bx, 0, 1);
-                        aux.plus(bfab[idim], bx, bx, 0, 0, 1);
-                    }
+                        bz_aux(j,k,l) = bz_fp(j,k,l)
+                            + warpx_interp_div_free_bz(j,k,l,bx_c,bx_cp,bz_c,bz_cp,dxc,dzc,rr);
+                    });
+#endif
                 }
             }
-        }
 
-        // E field
-        {
-            MultiFab dEx(Efield_cp[lev][0]->boxArray(), dm, 1, ng);
-            MultiFab dEy(Efield_cp[lev][1]->boxArray(), dm, 1, ng);
-            MultiFab dEz(Efield_cp[lev][2]->boxArray(), dm, 1, ng);
-            dEx.setVal(0.0);
-            dEy.setVal(0.0);
-            dEz.setVal(0.0);
-            dEx.ParallelCopy(*Efield_aux[lev-1][0], 0, 0, 1, ng, ng, crse_period);
-            dEy.ParallelCopy(*Efield_aux[lev-1][1], 0, 0, 1, ng, ng, crse_period);
-            dEz.ParallelCopy(*Efield_aux[lev-1][2], 0, 0, 1, ng, ng, crse_period);
-            if (Efield_cax[lev][0])
+            // E field
             {
-                MultiFab::Copy(*Efield_cax[lev][0], dEx, 0, 0, 1, ng);
-                MultiFab::Copy(*Efield_cax[lev][1], dEy, 0, 0, 1, ng);
-                MultiFab::Copy(*Efield_cax[lev][2], dEz, 0, 0, 1, ng);
-            }
-            MultiFab::Subtract(dEx, *Efield_cp[lev][0], 0, 0, 1, ng);
-            MultiFab::Subtract(dEy, *Efield_cp[lev][1], 0, 0, 1, ng);
-            MultiFab::Subtract(dEz, *Efield_cp[lev][2], 0, 0, 1, ng);
-
-            const int ref_ratio = refRatio(lev-1)[0];
-#ifdef _OPEMP
-#pragma omp parallel
-#endif
-            {
-                std::array<FArrayBox,3> efab;
-                for (MFIter mfi(*Efield_aux[lev][0]); mfi.isValid(); ++mfi)
+                auto const& ex_aux = Efield_aux[lev][0]->array(mfi);
+                auto const& ey_aux = Efield_aux[lev][1]->array(mfi);
+                auto const& ez_aux = Efield_aux[lev][2]->array(mfi);
+                auto const& ex_fp = Efield_fp[lev][0]->array(mfi);
+                auto const& ey_fp = Efield_fp[lev][1]->array(mfi);
+                auto const& ez_fp = Efield_fp[lev][2]->array(mfi);
+                auto const& ex_cp = Efield_cp[lev][0]->array(mfi);
+                auto const& ey_cp = Efield_cp[lev][1]->array(mfi);
+                auto const& ez_cp = Efield_cp[lev][2]->array(mfi);
+                auto const& ex_c = Ecrse[0]->array(mfi);
+                auto const& ey_c = Ecrse[1]->array(mfi);
+                auto const& ez_c = Ecrse[2]->array(mfi);
+
+                const Box& tex = (*Efield_aux[lev][0])[mfi].box();
+                const Box& tey = (*Efield_aux[lev][1])[mfi].box();
+                const Box& tez = (*Efield_aux[lev][2])[mfi].box();
+
+                amrex::ParallelFor(tex,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
                 {
-                    Box ccbx = mfi.fabbox();
-                    ccbx.enclosedCells();
-                    ccbx.coarsen(ref_ratio).refine(ref_ratio); // so that ccbx is coarsenable
-
-                    const FArrayBox& cxfab = dEx[mfi];
-                    const FArrayBox& cyfab = dEy[mfi];
-                    const FArrayBox& czfab = dEz[mfi];
-                    efab[0].resize(amrex::convert(ccbx,Ex_nodal_flag));
-                    efab[1].resize(amrex::convert(ccbx,Ey_nodal_flag));
-                    efab[2].resize(amrex::convert(ccbx,Ez_nodal_flag));
-
-#if (AMREX_SPACEDIM == 3)
-                    amrex_interp_efield(ccbx.loVect(), ccbx.hiVect(),
-                                        BL_TO_FORTRAN_ANYD(efab[0]),
-                                        BL_TO_FORTRAN_ANYD(efab[1]),
-                                        BL_TO_FORTRAN_ANYD(efab[2]),
-                                        BL_TO_FORTRAN_ANYD(cxfab),
-                                        BL_TO_FORTRAN_ANYD(cyfab),
-                                        BL_TO_FORTRAN_ANYD(czfab),
-                                        &ref_ratio,&use_limiter);
-#else
-                    amrex_interp_efield(ccbx.loVect(), ccbx.hiVect(),
-                                        BL_TO_FORTRAN_ANYD(efab[0]),
-                                        BL_TO_FORTRAN_ANYD(efab[2]),
-                                        BL_TO_FORTRAN_ANYD(cxfab),
-                                        BL_TO_FORTRAN_ANYD(czfab),
-                                        &ref_ratio,&use_limiter);
-                    amrex_interp_nd_efield(ccbx.loVect(), ccbx.hiVect(),
-                                           BL_TO_FORTRAN_ANYD(efab[1]),
-                                           BL_TO_FORTRAN_ANYD(cyfab),
-                                           &ref_ratio);
-#endif
-
-                    for (int idim = 0; idim < 3; ++idim)
-                    {
-                        FArrayBox& aux = (*Efield_aux[lev][idim])[mfi];
-                        FArrayBox& fp  =  (*Efield_fp[lev][idim])[mfi];
-                        const Box& bx = aux.box();
-                        aux.copy(fp, bx, 0, bx, 0, 1);
-                        aux.plus(efab[idim], bx, bx, 0, 0, 1);
-                    }
-                }
+                    ex_aux(j,k,l) = ex_fp(j,k,l) + warpx_interp_linear(j,k,l,ex_c,ex_cp,Ex_nodal,rr);
+                });
+                amrex::ParallelFor(tey,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    ey_aux(j,k,l) = ey_fp(j,k,l) + warpx_interp_linear(j,k,l,ey_c,ey_cp,Ey_nodal,rr);
+                });
+                amrex::ParallelFor(tez,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    ez_aux(j,k,l) = ez_fp(j,k,l) + warpx_interp_linear(j,k,l,ez_c,ez_cp,Ez_nodal,rr);
+                });
             }
         }
     }
@@ -234,6 +250,67 @@ WarpX::FillBoundaryF ()
     }
 }
 
+void
+WarpX::FillBoundaryEB ()
+{
+#ifndef WARPX_USE_PY
+    // Nothing to do if E and B were not modified since the last call
+    bool filled = true;
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        filled = filled && (guards_filled_version[lev] == field_version[lev]);
+    }
+    if (filled) return;
+#endif
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        if (do_pml && pml[lev]->ok())
+        {
+            for (PatchType patch_type : {PatchType::fine, PatchType::coarse})
+            {
+                if (patch_type == PatchType::coarse && lev == 0) continue;
+                const auto& E = (patch_type == PatchType::fine) ? Efield_fp[lev] : Efield_cp[lev];
+                const auto& B = (patch_type == PatchType::fine) ? Bfield_fp[lev] : Bfield_cp[lev];
+                pml[lev]->ExchangeE(patch_type, {E[0].get(), E[1].get(), E[2].get()});
+                pml[lev]->FillBoundaryE(patch_type);
+                pml[lev]->ExchangeB(patch_type, {B[0].get(), B[1].get(), B[2].get()});
+                pml[lev]->FillBoundaryB(patch_type);
+            }
+        }
+    }
+
+    Vector<MultiFab*> mf;
+    Vector<Periodicity> period;
+    GetExchangeList(Efield_fp, Efield_cp, mf, period);
+    GetExchangeList(Bfield_fp, Bfield_cp, mf, period);
+    guard_cell_exchange.FillBoundary(mf, period);
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        MarkFieldsModified(lev);
+        guards_filled_version[lev] = field_version[lev];
+    }
+}
+
+void
+WarpX::GetExchangeList (const Vector<std::array<std::unique_ptr<MultiFab>,3> >& fp,
+                        const Vector<std::array<std::unique_ptr<MultiFab>,3> >& cp,
+                        Vector<MultiFab*>& mf, Vector<Periodicity>& period) const
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        for (int i = 0; i < 3; ++i) {
+            mf.push_back(fp[lev][i].get());
+            period.push_back(Geom(lev).periodicity());
+        }
+        if (lev > 0) {
+            for (int i = 0; i < 3; ++i) {
+                mf.push_back(cp[lev][i].get());
+                period.push_back(Geom(lev-1).periodicity());
+            }
+        }
+    }
+}
+
 void
 WarpX::FillBoundaryE(int lev)
 {
@@ -244,6 +321,8 @@ WarpX::FillBoundaryE(int lev)
 void
 WarpX::FillBoundaryE (int lev, PatchType patch_type)
 {
+    MarkFieldsModified(lev);
+
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -257,7 +336,7 @@ WarpX::FillBoundaryE (int lev, PatchType patch_type)
 
         const auto& period = Geom(lev).periodicity();
         Vector<MultiFab*> mf{Efield_fp[lev][0].get(),Efield_fp[lev][1].get(),Efield_fp[lev][2].get()};
-        amrex::FillBoundary(mf, period);
+        guard_cell_exchange.FillBoundary(mf, period);
     }
     else if (patch_type == PatchType::coarse)
     {
@@ -272,7 +351,7 @@ WarpX::FillBoundaryE (int lev, PatchType patch_type)
 
         const auto& cperiod = Geom(lev-1).periodicity();
         Vector<MultiFab*> mf{Efield_cp[lev][0].get(),Efield_cp[lev][1].get(),Efield_cp[lev][2].get()};
-        amrex::FillBoundary(mf, cperiod);
+        guard_cell_exchange.FillBoundary(mf, cperiod);
     }
 }
 
@@ -286,6 +365,8 @@ WarpX::FillBoundaryB (int lev)
 void
 WarpX::FillBoundaryB (int lev, PatchType patch_type)
 {
+    MarkFieldsModified(lev);
+
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -298,7 +379,7 @@ WarpX::FillBoundaryB (int lev, PatchType patch_type)
         }
         const auto& period = Geom(lev).periodicity();
         Vector<MultiFab*> mf{Bfield_fp[lev][0].get(),Bfield_fp[lev][1].get(),Bfield_fp[lev][2].get()};
-        amrex::FillBoundary(mf, period);
+        guard_cell_exchange.FillBoundary(mf, period);
     }
     else if (patch_type == PatchType::coarse)
     {
@@ -312,7 +393,163 @@ WarpX::FillBoundaryB (int lev, PatchType patch_type)
         }
         const auto& cperiod = Geom(lev-1).periodicity();
         Vector<MultiFab*> mf{Bfield_cp[lev][0].get(),Bfield_cp[lev][1].get(),Bfield_cp[lev][2].get()};
-        amrex::FillBoundary(mf, cperiod);
+        guard_cell_exchange.FillBoundary(mf, cperiod);
+    }
+}
+
+void
+WarpX::FillBoundary_nowait (const Vector<MultiFab*>& mf, const Vector<Periodicity>& period)
+{
+    BL_PROFILE("WarpX::FillBoundary_nowait()");
+    const Real t = amrex::second();
+    guard_cell_exchange.FillBoundary_nowait(mf, period);
+    const Real t_end = amrex::second();
+    comm_time_exposed += t_end - t;
+    if (comm_hidden_start < 0.) comm_hidden_start = t_end;
+}
+
+void
+WarpX::FillBoundary_finish (const Vector<MultiFab*>& mf)
+{
+    // The time spent here, waiting for the messages, is the exposed communication time
+    BL_PROFILE("WarpX::FillBoundary_finish()");
+    const Real t = amrex::second();
+    if (comm_hidden_start >= 0.) {
+        comm_time_hidden += t - comm_hidden_start;
+        comm_hidden_start = -1.;
+    }
+    guard_cell_exchange.FillBoundary_finish(mf);
+    comm_time_exposed += amrex::second() - t;
+}
+
+void
+WarpX::FillBoundaryE_nowait ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        // As in FillBoundaryE, the exchange with the PML (which overwrites
+        // the guard cells) is done before the exchange between boxes
+        if (do_pml && pml[lev]->ok())
+        {
+            pml[lev]->ExchangeE(PatchType::fine,
+                                { Efield_fp[lev][0].get(),
+                                  Efield_fp[lev][1].get(),
+                                  Efield_fp[lev][2].get() });
+            pml[lev]->FillBoundaryE(PatchType::fine);
+            if (lev > 0) {
+                pml[lev]->ExchangeE(PatchType::coarse,
+                                    { Efield_cp[lev][0].get(),
+                                      Efield_cp[lev][1].get(),
+                                      Efield_cp[lev][2].get() });
+                pml[lev]->FillBoundaryE(PatchType::coarse);
+            }
+        }
+    }
+
+    // All the components and levels are exchanged together
+    Vector<MultiFab*> mf;
+    Vector<Periodicity> period;
+    GetExchangeList(Efield_fp, Efield_cp, mf, period);
+    FillBoundary_nowait(mf, period);
+}
+
+void
+WarpX::FillBoundaryB_nowait ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        if (do_pml && pml[lev]->ok())
+        {
+            pml[lev]->ExchangeB(PatchType::fine,
+                                { Bfield_fp[lev][0].get(),
+                                  Bfield_fp[lev][1].get(),
+                                  Bfield_fp[lev][2].get() });
+            pml[lev]->FillBoundaryB(PatchType::fine);
+            if (lev > 0) {
+                pml[lev]->ExchangeB(PatchType::coarse,
+                                    { Bfield_cp[lev][0].get(),
+                                      Bfield_cp[lev][1].get(),
+                                      Bfield_cp[lev][2].get() });
+                pml[lev]->FillBoundaryB(PatchType::coarse);
+            }
+        }
+    }
+
+    // All the components and levels are exchanged together
+    Vector<MultiFab*> mf;
+    Vector<Periodicity> period;
+    GetExchangeList(Bfield_fp, Bfield_cp, mf, period);
+    FillBoundary_nowait(mf, period);
+}
+
+void
+WarpX::FillBoundaryF_nowait ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        if (do_pml && pml[lev]->ok())
+        {
+            if (F_fp[lev]) {
+                pml[lev]->ExchangeF(PatchType::fine, F_fp[lev].get());
+                pml[lev]->FillBoundaryF(PatchType::fine);
+            }
+            if (lev > 0 && F_cp[lev]) {
+                pml[lev]->ExchangeF(PatchType::coarse, F_cp[lev].get());
+                pml[lev]->FillBoundaryF(PatchType::coarse);
+            }
+        }
+    }
+
+    Vector<MultiFab*> mf;
+    Vector<Periodicity> period;
+    GetExchangeListF(mf, period);
+    if (!mf.empty()) FillBoundary_nowait(mf, period);
+}
+
+void
+WarpX::FillBoundaryE_finish ()
+{
+    MarkFieldsModified();
+
+    Vector<MultiFab*> mf;
+    Vector<Periodicity> period;
+    GetExchangeList(Efield_fp, Efield_cp, mf, period);
+    FillBoundary_finish(mf);
+}
+
+void
+WarpX::FillBoundaryB_finish ()
+{
+    MarkFieldsModified();
+
+    Vector<MultiFab*> mf;
+    Vector<Periodicity> period;
+    GetExchangeList(Bfield_fp, Bfield_cp, mf, period);
+    FillBoundary_finish(mf);
+}
+
+void
+WarpX::FillBoundaryF_finish ()
+{
+    Vector<MultiFab*> mf;
+    Vector<Periodicity> period;
+    GetExchangeListF(mf, period);
+    if (!mf.empty()) FillBoundary_finish(mf);
+}
+
+void
+WarpX::GetExchangeListF (Vector<MultiFab*>& mf, Vector<Periodicity>& period) const
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        if (F_fp[lev]) {
+            mf.push_back(F_fp[lev].get());
+            period.push_back(Geom(lev).periodicity());
+        }
+        if (lev > 0 && F_cp[lev]) {
+            mf.push_back(F_cp[lev].get());
+            period.push_back(Geom(lev-1).periodicity());
+        }
     }
 }
 
@@ -335,7 +572,7 @@ WarpX::FillBoundaryF (int lev, PatchType patch_type)
         }
 
         const auto& period = Geom(lev).periodicity();
-        F_fp[lev]->FillBoundary(period);
+        guard_cell_exchange.FillBoundary({F_fp[lev].get()}, period);
     }
     else if (patch_type == PatchType::coarse && F_cp[lev])
     {
@@ -346,7 +583,7 @@ WarpX::FillBoundaryF (int lev, PatchType patch_type)
         }
 
         const auto& cperiod = Geom(lev-1).periodicity();
-        F_cp[lev]->FillBoundary(cperiod);
+        guard_cell_exchange.FillBoundary({F_cp[lev].get()}, cperiod);
     }
 }
 
@@ -523,33 +760,36 @@ WarpX::SyncCurrent (const std::array<const amrex::MultiFab*,3>& fine,
                     const std::array<      amrex::MultiFab*,3>& crse,
                     int ref_ratio)
 {
-    BL_ASSERT(ref_ratio == 2);
     const IntVect& ng = (fine[0]->nGrowVect() + 1) /ref_ratio;
 
-#ifdef _OPEMP
+#ifdef _OPENMP
 #pragma omp parallel
 #endif
     {
         FArrayBox ffab;
         for (int idim = 0; idim < 3; ++idim)
         {
+            const IntVect nodal = crse[idim]->ixType().toIntVect();
             for (MFIter mfi(*crse[idim],true); mfi.isValid(); ++mfi)
             {
                 const Box& bx = mfi.growntilebox(ng);
-                Box fbx = amrex::grow(amrex::refine(bx,ref_ratio),1);
+                Box fbx = amrex::grow(amrex::refine(bx,ref_ratio),ref_ratio-1);
                 ffab.resize(fbx);
                 fbx &= (*fine[idim])[mfi].box();
                 ffab.setVal(0.0);
                 ffab.copy((*fine[idim])[mfi], fbx, 0, fbx, 0, 1);
-                WRPX_SYNC_CURRENT(bx.loVect(), bx.hiVect(),
-                                   BL_TO_FORTRAN_ANYD((*crse[idim])[mfi]),
-                                   BL_TO_FORTRAN_ANYD(ffab),
-                                   &idim);
+
+                auto const& c = crse[idim]->array(mfi);
+                auto const& f = static_cast<const FArrayBox&>(ffab).array();
+                amrex::ParallelFor(bx,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_restrict(j,k,l,0,c,f,nodal,ref_ratio);
+                });
             }
         }
     }
 }
-
 void
 WarpX::SyncRho (amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rhof,
                 amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rhoc)
@@ -671,11 +911,11 @@ WarpX::SyncRho (amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rhof,
 void
 WarpX::SyncRho (const MultiFab& fine, MultiFab& crse, int ref_ratio)
 {
-    BL_ASSERT(ref_ratio == 2);
     const IntVect& ng = (fine.nGrowVect()+1)/ref_ratio;
     const int nc = fine.nComp();
+    const IntVect nodal = crse.ixType().toIntVect();
 
-#ifdef _OPEMP
+#ifdef _OPENMP
 #pragma omp parallel
 #endif
     {
@@ -683,15 +923,21 @@ WarpX::SyncRho (const MultiFab& fine, MultiFab& crse, int ref_ratio)
         for (MFIter mfi(crse,true); mfi.isValid(); ++mfi)
         {
             const Box& bx = mfi.growntilebox(ng);
-            Box fbx = amrex::grow(amrex::refine(bx,ref_ratio),1);
+            Box fbx = amrex::grow(amrex::refine(bx,ref_ratio),ref_ratio-1);
             ffab.resize(fbx, nc);
             fbx &= fine[mfi].box();
             ffab.setVal(0.0);
             ffab.copy(fine[mfi], fbx, 0, fbx, 0, nc);
-            WRPX_SYNC_RHO(bx.loVect(), bx.hiVect(),
-                          BL_TO_FORTRAN_ANYD(crse[mfi]),
-                          BL_TO_FORTRAN_ANYD(ffab),
-                          &nc);
+
+            auto const& c = crse.array(mfi);
+            auto const& f = static_cast<const FArrayBox&>(ffab).array();
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_DEVICE (int j, int k, int l)
+            {
+                for (int n = 0; n < nc; ++n) {
+                    warpx_restrict(j,k,l,n,c,f,nodal,ref_ratio);
+                }
+            });
         }
     }
 }
@@ -2,8 +2,159 @@
 #include <WarpX.H>
 #include <AMReX_BLProfiler.H>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace amrex;
 
+namespace
+{
+    // Least-squares fit of cost[i] = sum_k w[k]*x[k][i], with w[k] >= 0:
+    // the terms that get a negative weight are dropped and the fit redone.
+    // Returns an empty vector if no term is left.
+    Vector<Real> FitCostWeights (const Vector<Real>& cost,
+                                 const Vector<Vector<Real> >& x)
+    {
+        const int nterms = x.size();
+        Vector<int> active(nterms, 1);
+        for (int iter = 0; iter < nterms; ++iter)
+        {
+            Vector<int> k;
+            for (int i = 0; i < nterms; ++i) if (active[i]) k.push_back(i);
+            const int n = k.size();
+            if (n == 0) return Vector<Real>();
+
+            // Normal equations, with a small regularization for the
+            // (nearly) collinear terms, e.g. the number of particles and
+            // of cells with a uniform plasma
+            Vector<Real> a(n*(n+1), 0.);
+            for (int i = 0, N = cost.size(); i < N; ++i) {
+                for (int p = 0; p < n; ++p) {
+                    for (int q = 0; q < n; ++q) {
+                        a[p*(n+1)+q] += x[k[p]][i]*x[k[q]][i];
+                    }
+                    a[p*(n+1)+n] += x[k[p]][i]*cost[i];
+                }
+            }
+            for (int p = 0; p < n; ++p) {
+                a[p*(n+1)+p] *= 1. + 1.e-10;
+                if (a[p*(n+1)+p] == 0.) a[p*(n+1)+p] = 1.;
+            }
+            // Gaussian elimination (the matrix is symmetric positive definite)
+            for (int p = 0; p < n; ++p) {
+                for (int r = p+1; r < n; ++r) {
+                    const Real f = a[r*(n+1)+p]/a[p*(n+1)+p];
+                    for (int q = p; q <= n; ++q) a[r*(n+1)+q] -= f*a[p*(n+1)+q];
+                }
+            }
+            Vector<Real> wk(n);
+            for (int p = n-1; p >= 0; --p) {
+                Real r = a[p*(n+1)+n];
+                for (int q = p+1; q < n; ++q) r -= a[p*(n+1)+q]*wk[q];
+                wk[p] = r/a[p*(n+1)+p];
+            }
+
+            bool all_positive = true;
+            for (int p = 0; p < n; ++p) {
+                if (wk[p] < 0.) {
+                    active[k[p]] = 0;
+                    all_positive = false;
+                }
+            }
+            if (all_positive) {
+                Vector<Real> w(nterms, 0.);
+                for (int p = 0; p < n; ++p) w[k[p]] = wk[p];
+                return w;
+            }
+        }
+        return Vector<Real>();
+    }
+
+    // Load of the most loaded rank, and average load
+    std::pair<Real,Real> RankLoads (const Vector<Real>& cost, const DistributionMapping& dm)
+    {
+        const int nprocs = ParallelDescriptor::NProcs();
+        Vector<Real> load(nprocs, 0.);
+        for (int i = 0, N = cost.size(); i < N; ++i) {
+            load[dm[i]] += cost[i];
+        }
+        const Real maxload = *std::max_element(load.begin(), load.end());
+        const Real avgload = std::accumulate(load.begin(), load.end(), 0.)/nprocs;
+        return std::make_pair(maxload, avgload);
+    }
+}
+
+/* \brief Cost of each box of level lev (the same on all ranks), and its
+ *  number of particles (npart).
+ *
+ *  The cost of a box is the time spent in the particle and field pushes in
+ *  the box and in the PML around it (which moves with the box, see
+ *  RemakeLevel), or, with LoadBalanceCostsType::Heuristic, a model of this
+ *  time: w_p*(number of particles) + w_c*(number of cells) + w_pml*(number
+ *  of PML cells), whose weights are fitted to the measured times of all the
+ *  boxes of the level. The model uses the current number of particles, and
+ *  therefore also applies to boxes whose content has changed since the
+ *  times were measured (e.g. with plasma injection).
+ *  The costs are in seconds per costs_nsteps steps.
+ */
+Vector<Real>
+WarpX::BoxCosts (int lev, LoadBalanceCostsType costs_type, Vector<Real>& npart) const
+{
+    const BoxArray& ba = boxArray(lev);
+    const int nboxes = ba.size();
+    const bool has_pml = do_pml && pml[lev] && pml[lev]->ok();
+
+    // Measured cost of each box
+    Vector<Real> cost(nboxes, 0.);
+    for (MFIter mfi(*costs[lev]); mfi.isValid(); ++mfi) {
+        cost[mfi.index()] = (*costs[lev])[mfi].sum(mfi.validbox(), 0);
+    }
+    ParallelDescriptor::ReduceRealSum(cost.data(), cost.size());
+    if (has_pml) {
+        const Vector<Real>& pml_cost = pml[lev]->CostsPerGrid();
+        for (int i = 0; i < nboxes; ++i) cost[i] += pml_cost[i];
+    }
+
+    npart.resize(nboxes);
+    {
+        const Vector<long>& np = mypc->NumberOfParticlesInGrid(lev);
+        for (int i = 0; i < nboxes; ++i) npart[i] = np[i];
+    }
+
+    if (costs_type == LoadBalanceCostsType::Heuristic)
+    {
+        Vector<Real> ncell(nboxes);
+        for (int i = 0; i < nboxes; ++i) ncell[i] = ba[i].d_numPts();
+        const Vector<Real>& npml = (has_pml) ? pml[lev]->NumCellsPerGrid()
+                                             : Vector<Real>(nboxes, 0.);
+        const Vector<Real>& w = FitCostWeights(cost, {npart, ncell, npml});
+        if (w.empty()) {
+            amrex::Print() << "LoadBalance: the cost model could not be fitted on level "
+                           << lev << "; using the measured costs\n";
+        } else {
+            for (int i = 0; i < nboxes; ++i) {
+                cost[i] = w[0]*npart[i] + w[1]*ncell[i] + w[2]*npml[i];
+            }
+            if (verbose) {
+                const Real nsteps = std::max(costs_nsteps, 1.);
+                amrex::Print() << "LoadBalance: cost model on level " << lev
+                               << ": " << w[0]/nsteps << " s per particle, "
+                               << w[1]/nsteps << " s per cell, "
+                               << w[2]/nsteps << " s per PML cell\n";
+            }
+        }
+    }
+
+    return cost;
+}
+
+/* \brief Redistributes the boxes of each level according to their costs
+ *  (see BoxCosts).
+ *
+ *  With warpx.load_balance_with_hysteresis, a level is only redistributed
+ *  if the predicted gain over the next load_balance_int steps exceeds the
+ *  predicted time of the migration (from the time of the last migration).
+ */
 void
 WarpX::LoadBalance ()
 {
@@ -12,23 +163,202 @@ WarpX::LoadBalance ()
 
     AMREX_ALWAYS_ASSERT(costs[0] != nullptr);
 
+    const Real nprocs = ParallelDescriptor::NProcs();
+    const Real nsteps = std::max(costs_nsteps, 1.);
+
+    Vector<DistributionMapping> newdm(finestLevel()+1);
+    Vector<int> remake(finestLevel()+1, 0);
+    Real migration_size = 0.;
+
     for (int lev = 0; lev <= finestLevel(); ++lev)
     {
-        const Real nboxes = costs[lev]->size();
-        const Real nprocs = ParallelDescriptor::NProcs();
+        const BoxArray& ba = boxArray(lev);
+        const DistributionMapping& olddm = DistributionMap(lev);
+        const int nboxes = ba.size();
+
+        Vector<Real> npart;
+        const Vector<Real>& cost = BoxCosts(lev, load_balance_costs_type, npart);
+
+        MultiFab weight(ba, olddm, 1, 0);
+        for (MFIter mfi(weight); mfi.isValid(); ++mfi) {
+            weight[mfi].setVal(cost[mfi.index()]/ba[mfi.index()].d_numPts());
+        }
         const int nmax = static_cast<int>(std::ceil(nboxes/nprocs*load_balance_knapsack_factor));
-        const DistributionMapping newdm = (load_balance_with_sfc)
-	  ? DistributionMapping::makeSFC(*costs[lev], false)
-            : DistributionMapping::makeKnapSack(*costs[lev], nmax);
-        RemakeLevel(lev, t_new[lev], boxArray(lev), newdm);
+        const DistributionMapping dm = (load_balance_with_sfc)
+            ? DistributionMapping::makeSFC(weight, false)
+            : DistributionMapping::makeKnapSack(weight, nmax);
+
+        const auto& oldload = RankLoads(cost, olddm);
+        const auto& newload = RankLoads(cost, dm);
+
+        Real level_migration_size = 0.;
+        for (int i = 0; i < nboxes; ++i) {
+            if (dm[i] != olddm[i]) level_migration_size += ba[i].d_numPts() + npart[i];
+        }
+        const Real gain = (oldload.first - newload.first)/nsteps*load_balance_int;
+        const Real migration_time = load_balance_migration_time*level_migration_size;
+
+        if (load_balance_with_hysteresis && gain <= migration_time) {
+            if (verbose) {
+                amrex::Print() << "LoadBalance: level " << lev << " not redistributed"
+                               << " (predicted gain " << gain << " s, migration "
+                               << migration_time << " s)\n";
+            }
+            continue;
+        }
+
+        if (verbose) {
+            amrex::Print() << "LoadBalance: level " << lev << ", efficiency "
+                           << ((oldload.first > 0.) ? oldload.second/oldload.first : 1.)
+                           << " -> "
+                           << ((newload.first > 0.) ? newload.second/newload.first : 1.)
+                           << "\n";
+        }
+        newdm[lev] = dm;
+        remake[lev] = 1;
+        migration_size += level_migration_size;
     }
 
+    const Real t0 = amrex::second();
+
+    bool remade = false;
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        if (remake[lev]) {
+            RemakeLevel(lev, t_new[lev], boxArray(lev), newdm[lev]);
+            remade = true;
+        }
+    }
+
+    if (remade)
+    {
+        mypc->Redistribute();
+
+        Real migration_time = amrex::second() - t0;
+        ParallelDescriptor::ReduceRealMax(migration_time);
+        if (migration_size > 0.) {
+            load_balance_migration_time = migration_time/migration_size;
+        }
+    }
+}
+
+/* \brief Incremental load balance of the boxes of level 0 at the front of
+ *  the moving window, where the plasma is injected (see MoveWindow).
+ *
+ *  The injected plasma piles up on the ranks that own these boxes. Instead
+ *  of redistributing all the boxes, each box of the front whose rank is
+ *  more loaded than the average (by more than load_balance_injection_threshold)
+ *  is moved to the least loaded rank, if this reduces the larger of the two
+ *  loads. The costs are those of the model (see BoxCosts), which accounts
+ *  for the particles injected since the times were measured. Only the boxes
+ *  that are moved are communicated.
+ *
+ *  Returns whether boxes were moved, in which case the particles have been
+ *  redistributed.
+ */
+bool
+WarpX::LoadBalanceInjectionRegion ()
+{
+    BL_PROFILE("WarpX::LoadBalanceInjectionRegion()");
+
+    const int lev = 0;
+    const int dir = moving_window_dir;
+    const BoxArray& ba = boxArray(lev);
+    const DistributionMapping& olddm = DistributionMap(lev);
+    const Box& domain = Geom(lev).Domain();
+    const int nboxes = ba.size();
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    Vector<Real> npart;
+    const Vector<Real>& cost = BoxCosts(lev, LoadBalanceCostsType::Heuristic, npart);
+
+    Vector<Real> load(nprocs, 0.);
+    for (int i = 0; i < nboxes; ++i) load[olddm[i]] += cost[i];
+    const Real avgload = std::accumulate(load.begin(), load.end(), 0.)/nprocs;
+
+    // Boxes at the front of the window, most expensive first
+    Vector<int> front;
+    for (int i = 0; i < nboxes; ++i) {
+        const bool at_front = (moving_window_v >= 0)
+            ? ba[i].bigEnd(dir) == domain.bigEnd(dir)
+            : ba[i].smallEnd(dir) == domain.smallEnd(dir);
+        if (at_front) front.push_back(i);
+    }
+    std::sort(front.begin(), front.end(),
+              [&cost] (int a, int b) { return cost[a] > cost[b]; });
+
+    Vector<int> pmap = olddm.ProcessorMap();
+    Real migration_size = 0.;
+    for (int i : front)
+    {
+        const int src = pmap[i];
+        if (load[src] <= avgload*(1.+load_balance_injection_threshold)) continue;
+        const int dst = std::min_element(load.begin(), load.end()) - load.begin();
+        if (load[dst] + cost[i] < load[src]) {
+            load[src] -= cost[i];
+            load[dst] += cost[i];
+            pmap[i] = dst;
+            migration_size += ba[i].d_numPts() + npart[i];
+        }
+    }
+
+    if (migration_size == 0.) return false;
+
+    const Real oldmax = RankLoads(cost, olddm).first;
+    const Real newmax = *std::max_element(load.begin(), load.end());
+
+    if (load_balance_with_hysteresis)
+    {
+        const Real nsteps = std::max(costs_nsteps, 1.);
+        const Real gain = (oldmax - newmax)/nsteps*load_balance_int;
+        if (gain <= load_balance_migration_time*migration_size) return false;
+    }
+
+    const Real t0 = amrex::second();
+
+    RemakeLevel(lev, t_new[lev], ba, DistributionMapping(pmap));
+    // RemakeLevel zeroed the costs of this level: restart the running
+    // average (costs_nsteps included) on all levels, as after LoadBalance
+    ResetCosts();
     mypc->Redistribute();
+
+    Real migration_time = amrex::second() - t0;
+    ParallelDescriptor::ReduceRealMax(migration_time);
+    load_balance_migration_time = migration_time/migration_size;
+
+    if (verbose) {
+        amrex::Print() << "LoadBalanceInjectionRegion: efficiency "
+                       << avgload/oldmax << " -> " << avgload/newmax << "\n";
+    }
+
+    return true;
+}
+
+void
+WarpX::ScaleCosts (Real fac)
+{
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        if (costs[lev]) costs[lev]->mult(fac);
+        if (do_pml && pml[lev]) pml[lev]->ScaleCosts(fac);
+    }
+    // The costs of the step that starts are added with a weight of 1
+    costs_nsteps = fac*costs_nsteps + 1.;
+}
+
+void
+WarpX::ResetCosts ()
+{
+    ScaleCosts(0.);
+    costs_nsteps = 0.;
 }
 
 void
 WarpX::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapping& dm)
 {
+    // The communication patterns of the fields are not valid anymore
+    guard_cell_exchange.ClearCache();
+    shift_staging.clear();
+
     if (ba == boxArray(lev))
     {
         if (ParallelDescriptor::NProcs() == 1) return;
@@ -175,6 +505,7 @@ WarpX::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMa
                     auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Bfield_cax[lev][idim]->boxArray(),
                                                                       dm, 1, ng));
                     // pmf->ParallelCopy(*Bfield_cax[lev][idim], 0, 0, 1, ng, ng);
+                    pmf->setVal(0.0);
                     Bfield_cax[lev][idim] = std::move(pmf);
                 }
                 if (Efield_cax[lev][idim])
@@ -183,6 +514,7 @@ WarpX::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMa
                     auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Efield_cax[lev][idim]->boxArray(),
                                                                       dm, 1, ng));
                     // pmf->ParallelCopy(*Efield_cax[lev][idim], 0, 0, 1, ng, ng);
+                    pmf->setVal(0.0);
                     Efield_cax[lev][idim] = std::move(pmf);
                 }
                 if (current_buf[lev][idim])
@@ -220,12 +552,57 @@ WarpX::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMa
             }
         }
 
+        if (lev > 0) {
+            for (int idim=0; idim < 3; ++idim)
+            {
+                if (Bfield_aux_crse[lev][idim])
+                {
+                    const IntVect& ng = Bfield_aux_crse[lev][idim]->nGrowVect();
+                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Bfield_aux_crse[lev][idim]->boxArray(),
+                                                                      dm, 1, ng));
+                    pmf->setVal(0.0);
+                    Bfield_aux_crse[lev][idim] = std::move(pmf);
+                }
+                if (Efield_aux_crse[lev][idim])
+                {
+                    const IntVect& ng = Efield_aux_crse[lev][idim]->nGrowVect();
+                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Efield_aux_crse[lev][idim]->boxArray(),
+                                                                      dm, 1, ng));
+                    pmf->setVal(0.0);
+                    Efield_aux_crse[lev][idim] = std::move(pmf);
+                }
+            }
+        }
+
         if (costs[lev] != nullptr) {
             costs[lev].reset(new MultiFab(costs[lev]->boxArray(), dm, 1, 0));
             costs[lev]->setVal(0.0);
         }
 
+        // The PML boxes follow the grid box that they surround, so that
+        // their cost, which is included in the cost of this box, moves
+        // with it
+        if (do_pml && pml[lev]) {
+            pml[lev]->RemakeDistributionMap(dm);
+        }
+
         SetDistributionMap(lev, dm);
+
+#ifdef WARPX_USE_PSATD
+        // With local FFTs, the FFT boxes and the spectral solvers follow
+        // the distribution mapping of the grids: rebuild them. (With the
+        // hybrid decomposition, they are independent of it.)
+        if (fft_hybrid_mpi_decomposition == false) {
+            AllocLevelDataFFT(lev);
+            InitLevelDataFFT(lev, time);
+            // The new plans may have new shapes on this rank (measured
+            // with psatd.fftw_plan_measure): save their wisdom again
+            fftw_wisdom_saved = false;
+        }
+#endif
+
+        // The aux fields have not been redistributed
+        MarkFieldsModified(lev);
     }
     else
     {
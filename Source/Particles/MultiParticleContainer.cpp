@@ -49,6 +49,22 @@ MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
         pc_tmp->AddRealComp("uyold");
         pc_tmp->AddRealComp("uzold");
     }
+
+#ifdef WARPX_LEAN_PARTICLES
+    // The gathered fields are only stored in the particles when they are plotted.
+    // They are not communicated: FieldGather recomputes them before plotting.
+    if (WarpX::plot_particle_fields)
+    {
+        for (const auto& name : ParticleStringNames::field_names)
+        {
+            for (int i = 0; i < nspecies + nlasers; ++i)
+            {
+                allcontainers[i]->AddRealComp(name, false);
+            }
+            pc_tmp->AddRealComp(name, false);
+        }
+    }
+#endif
 }
 
 void
@@ -92,7 +108,13 @@ MultiParticleContainer::ReadParameters ()
         }
 
         pp.query("use_fdtd_nci_corr", WarpX::use_fdtd_nci_corr);
+        pp.query("nci_corr_filter_on_level", WarpX::nci_corr_filter_on_level);
         pp.query("l_lower_order_in_v", WarpX::l_lower_order_in_v);
+        pp.query("evolve_species_by_tile", evolve_species_by_tile);
+        // The tiles of all the species must be visited in the same order
+        // by each thread (see MultiParticleContainer::Evolve)
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!evolve_species_by_tile || !WarpX::do_dynamic_scheduling,
+            "particles.evolve_species_by_tile requires warpx.do_dynamic_scheduling = 0");
 
         ParmParse ppl("lasers");
         ppl.query("nlasers", nlasers);
@@ -254,9 +276,160 @@ MultiParticleContainer::Evolve (int lev,
     if (cjz) cjz->setVal(0.0);
     if (rho) rho->setVal(0.0);
     if (crho) crho->setVal(0.0);
+
+    std::array<const MultiFab*, 6> fp_fields {{&Ex, &Ey, &Ez, &Bx, &By, &Bz}};
+    std::array<const MultiFab*, 6> cp_fields {{cEx, cEy, cEz, cBx, cBy, cBz}};
+    if (WarpX::use_fdtd_nci_corr && WarpX::nci_corr_filter_on_level)
+    {
+        // Filter the fields once for all the species, instead of once per tile
+        // in each species
+        nci_filtered_fp.resize(lev+1);
+        nci_filtered_cp.resize(lev+1);
+        ApplyNCIFilter(lev, fp_fields, nci_filtered_fp[lev]);
+        if (cEx) ApplyNCIFilter(lev-1, cp_fields, nci_filtered_cp[lev]);
+    }
+
+    // The species evolved tile by tile. The tiles of all the species must be
+    // visited in the same order by each thread, which requires static scheduling.
+    std::vector<PhysicalParticleContainer*> tiled_containers;
+    if (evolve_species_by_tile && !WarpX::do_dynamic_scheduling) {
+        for (auto& pc : allcontainers) {
+            auto ppc = dynamic_cast<PhysicalParticleContainer*>(pc.get());
+            if (ppc) tiled_containers.push_back(ppc);
+        }
+    }
+
     for (auto& pc : allcontainers) {
-	pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
-               rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt);
+        if (std::find(tiled_containers.begin(), tiled_containers.end(), pc.get())
+            != tiled_containers.end()) continue;
+	pc->Evolve(lev,
+                   *fp_fields[0], *fp_fields[1], *fp_fields[2],
+                   *fp_fields[3], *fp_fields[4], *fp_fields[5],
+                   jx, jy, jz, cjx, cjy, cjz, rho, crho,
+                   cp_fields[0], cp_fields[1], cp_fields[2],
+                   cp_fields[3], cp_fields[4], cp_fields[5], t, dt);
+    }
+
+    if (tiled_containers.empty()) return;
+
+    BL_PROFILE("MultiParticleContainer::EvolveSpeciesByTile");
+
+    for (auto ppc : tiled_containers) {
+        ppc->PreEvolve(lev, dt);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+        int thread_num = omp_get_thread_num();
+#else
+        int thread_num = 0;
+#endif
+
+        PhysicalParticleContainer::TileFields tile_fields;
+
+        const int ncontainers = tiled_containers.size();
+        std::vector<std::unique_ptr<WarpXParIter> > iters;
+        for (auto ppc : tiled_containers) {
+            iters.emplace_back(new WarpXParIter(*ppc, lev));
+        }
+
+        while (true)
+        {
+            // Next tile of this thread where any of the species has particles.
+            // Each iterator only visits the tiles where its species has particles,
+            // in increasing order of (grid, tile).
+            bool found = false;
+            std::pair<int,int> tile;
+            for (auto& pti : iters) {
+                if (!pti->isValid()) continue;
+                const std::pair<int,int> t(pti->index(), pti->LocalTileIndex());
+                if (!found || t < tile) {
+                    tile = t;
+                    found = true;
+                }
+            }
+            if (!found) break;
+
+            // Prepare the fields of this tile once for all the species
+            bool fields_ready = false;
+            for (int i = 0; i < ncontainers; ++i)
+            {
+                WarpXParIter& pti = *iters[i];
+                if (!pti.isValid() || pti.index() != tile.first
+                    || pti.LocalTileIndex() != tile.second) continue;
+                if (!fields_ready) {
+                    PhysicalParticleContainer::SetTileFields(pti, lev, fp_fields, cp_fields,
+                                                             tile_fields);
+                    fields_ready = true;
+                }
+                tiled_containers[i]->EvolveTile(pti, tile_fields, jx, jy, jz, cjx, cjy, cjz,
+                                                rho, crho, thread_num, lev, dt);
+                ++pti;
+            }
+        }
+    }
+
+    for (auto ppc : tiled_containers) {
+        ppc->PostEvolve(lev);
+    }
+}
+
+void
+MultiParticleContainer::ApplyNCIFilter (int stencil_lev, std::array<const MultiFab*, 6>& fields,
+                                        std::array<std::unique_ptr<MultiFab>, 6>& filtered)
+{
+    BL_PROFILE("MultiParticleContainer::ApplyNCIFilter");
+
+    // The particles gather from the tile boxes grown by the shape order,
+    // as when the filter is applied per tile in PhysicalParticleContainer::Evolve
+#if (AMREX_SPACEDIM == 3)
+    const IntVect ng(static_cast<int>(WarpX::nox),
+                     static_cast<int>(WarpX::noy),
+                     static_cast<int>(WarpX::noz));
+    const std::array<int, 6> comps {{0, 1, 2, 3, 4, 5}};
+    const std::array<const Real*, 6> stencils {{
+        fdtd_nci_stencilz_ex[stencil_lev].data(), fdtd_nci_stencilz_ex[stencil_lev].data(),
+        fdtd_nci_stencilz_by[stencil_lev].data(), fdtd_nci_stencilz_by[stencil_lev].data(),
+        fdtd_nci_stencilz_by[stencil_lev].data(), fdtd_nci_stencilz_ex[stencil_lev].data()}};
+#else
+    const IntVect ng(static_cast<int>(WarpX::nox),
+                     static_cast<int>(WarpX::noz));
+    const std::array<int, 3> comps {{0, 2, 4}};
+    const std::array<const Real*, 3> stencils {{
+        fdtd_nci_stencilz_ex[stencil_lev].data(),
+        fdtd_nci_stencilz_by[stencil_lev].data(),
+        fdtd_nci_stencilz_by[stencil_lev].data()}};
+#endif
+    const int nstencilz = nstencilz_fdtd_nci_corr;
+
+    for (int i = 0; i < static_cast<int>(comps.size()); ++i)
+    {
+        const MultiFab& src = *fields[comps[i]];
+        std::unique_ptr<MultiFab>& dst = filtered[comps[i]];
+
+        // Only reallocate after regridding or load balancing
+        if (!dst || dst->boxArray() != src.boxArray()
+            || dst->DistributionMap() != src.DistributionMap())
+        {
+            dst.reset(new MultiFab(src.boxArray(), src.DistributionMap(), 1, ng));
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(*dst, true); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.growntilebox();
+            WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(bx),
+                                    BL_TO_FORTRAN_ANYD((*dst)[mfi]),
+                                    BL_TO_FORTRAN_ANYD(src[mfi]),
+                                    stencils[i], &nstencilz);
+        }
+
+        fields[comps[i]] = dst.get();
     }
 }
 
@@ -306,6 +479,7 @@ MultiParticleContainer::Redistribute ()
 {
     for (auto& pc : allcontainers) {
         pc->Redistribute();
+        if (WarpX::sort_on_redistribute) pc->SortParticlesInTiles();
     }
 }
 
@@ -314,6 +488,7 @@ MultiParticleContainer::RedistributeLocal (const int num_ghost)
 {
     for (auto& pc : allcontainers) {
         pc->Redistribute(0, 0, 0, num_ghost);
+        if (WarpX::sort_on_redistribute) pc->SortParticlesInTiles();
     }
 }
 
@@ -6,6 +6,12 @@
 #include <WarpX.H>
 #include <WarpXConst.H>
 #include <WarpXWrappers.h>
+#include <FieldGather.H>
+#include <UpdateMomentumBoris.H>
+#include <UpdateMomentumVay.H>
+#include <UpdatePosition.H>
+#include <CurrentDeposition.H>
+#include <ScratchArena.H>
 
 
 using namespace amrex;
@@ -988,7 +994,10 @@ PhysicalParticleContainer::FieldGather (int lev,
                                         const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
                                         const MultiFab& Bx, const MultiFab& By, const MultiFab& Bz)
 {
-    const std::array<Real,3>& dx = WarpX::CellSize(lev);
+#ifdef WARPX_LEAN_PARTICLES
+    // The gathered fields are only stored in the particles if they are plotted
+    if (!WarpX::plot_particle_fields) return;
+#endif
 
     // WarpX assumes the same number of guard cells for Ex, Ey, Ez, Bx, By, Bz
     long ng = Ex.nGrow();
@@ -1001,7 +1010,14 @@ PhysicalParticleContainer::FieldGather (int lev,
 #pragma omp parallel
 #endif
     {
-        Cuda::ManagedDeviceVector<Real> xp, yp, zp;
+#ifdef _OPENMP
+        int thread_num = omp_get_thread_num();
+#else
+        int thread_num = 0;
+#endif
+        auto& xp = m_xp[thread_num];
+        auto& yp = m_yp[thread_num];
+        auto& zp = m_zp[thread_num];
 
 	for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
 	{
@@ -1009,14 +1025,12 @@ PhysicalParticleContainer::FieldGather (int lev,
 
 	    const Box& box = pti.validbox();
 
-            auto& attribs = pti.GetAttribs();
-
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+            auto& Exp = pti.GetAttribs(particle_comps["Ex"]);
+            auto& Eyp = pti.GetAttribs(particle_comps["Ey"]);
+            auto& Ezp = pti.GetAttribs(particle_comps["Ez"]);
+            auto& Bxp = pti.GetAttribs(particle_comps["Bx"]);
+            auto& Byp = pti.GetAttribs(particle_comps["By"]);
+            auto& Bzp = pti.GetAttribs(particle_comps["Bz"]);
 
             const long np = pti.numParticles();
 
@@ -1040,33 +1054,14 @@ PhysicalParticleContainer::FieldGather (int lev,
 	    //
             pti.GetPosition(xp, yp, zp);
 
-            const std::array<Real,3>& xyzmin = WarpX::LowerCorner(box, lev);
-            const int* ixyzmin = box.loVect();
-
 	    //
 	    // Field Gather
 	    //
-	    const int ll4symtry          = false;
-            long lvect_fieldgathe = 64;
-	    warpx_geteb_energy_conserving(
-	       &np,
-               xp.dataPtr(),
-               yp.dataPtr(),
-               zp.dataPtr(),
-	       Exp.dataPtr(),Eyp.dataPtr(),Ezp.dataPtr(),
-	       Bxp.dataPtr(),Byp.dataPtr(),Bzp.dataPtr(),
-               ixyzmin,
-               &xyzmin[0], &xyzmin[1], &xyzmin[2],
-               &dx[0], &dx[1], &dx[2],
-	       &WarpX::nox, &WarpX::noy, &WarpX::noz,
-               BL_TO_FORTRAN_ANYD(exfab),
-	       BL_TO_FORTRAN_ANYD(eyfab),
-	       BL_TO_FORTRAN_ANYD(ezfab),
-               BL_TO_FORTRAN_ANYD(bxfab),
-	       BL_TO_FORTRAN_ANYD(byfab),
-	       BL_TO_FORTRAN_ANYD(bzfab),
-	       &ll4symtry, &WarpX::l_lower_order_in_v, &WarpX::do_nodal,
-	       &lvect_fieldgathe, &WarpX::field_gathering_algo);
+            GatherFields(xp.dataPtr(), yp.dataPtr(), zp.dataPtr(),
+                         Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+                         Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), np,
+                         exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                         box, lev, WarpX::l_lower_order_in_v);
 
             if (cost) {
                 const Box& tbx = pti.tilebox();
@@ -1081,6 +1076,71 @@ PhysicalParticleContainer::FieldGather (int lev,
     }
 }
 
+namespace
+{
+    // Apply the NCI filter with the stencils of level `stencil_lev` to the
+    // fields `fabs` (Ex, Ey, Ez, Bx, By, Bz) over the box `bx` grown by the
+    // shape order, store the results in `filtered` and point `fabs` to them.
+    // In 2D, only Ex, Ez and By are filtered.
+    void filterTileFields (std::array<const FArrayBox*, 6>& fabs,
+                           std::array<FArrayBox, 6>& filtered,
+                           const Box& bx, int stencil_lev)
+    {
+        const auto& mypc = WarpX::GetInstance().GetPartContainer();
+        const int nstencilz_fdtd_nci_corr = mypc.nstencilz_fdtd_nci_corr;
+        const Real* stencil_ex = mypc.fdtd_nci_stencilz_ex[stencil_lev].data();
+        const Real* stencil_by = mypc.fdtd_nci_stencilz_by[stencil_lev].data();
+
+#if (AMREX_SPACEDIM == 2)
+        const Box& tbox = amrex::grow(bx,{static_cast<int>(WarpX::nox),
+                    static_cast<int>(WarpX::noz)});
+        const std::array<int, 3> comps {{0, 2, 4}};
+        const std::array<const Real*, 3> stencils {{stencil_ex, stencil_by, stencil_by}};
+#else
+        const Box& tbox = amrex::grow(bx,{static_cast<int>(WarpX::nox),
+                    static_cast<int>(WarpX::noy),
+                    static_cast<int>(WarpX::noz)});
+        const std::array<int, 6> comps {{0, 1, 2, 3, 4, 5}};
+        const std::array<const Real*, 6> stencils {{stencil_ex, stencil_ex, stencil_by,
+                                                    stencil_by, stencil_by, stencil_ex}};
+#endif
+        const std::array<IntVect, 6> nodal_flags {{WarpX::Ex_nodal_flag, WarpX::Ey_nodal_flag,
+                                                   WarpX::Ez_nodal_flag, WarpX::Bx_nodal_flag,
+                                                   WarpX::By_nodal_flag, WarpX::Bz_nodal_flag}};
+
+        for (int i = 0; i < static_cast<int>(comps.size()); ++i)
+        {
+            const int comp = comps[i];
+            filtered[comp].resize(amrex::convert(tbox,nodal_flags[comp]));
+            WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered[comp]),
+                                    BL_TO_FORTRAN_ANYD(filtered[comp]),
+                                    BL_TO_FORTRAN_ANYD(*fabs[comp]),
+                                    stencils[i],
+                                    &nstencilz_fdtd_nci_corr);
+            fabs[comp] = &filtered[comp];
+        }
+    }
+}
+
+void
+PhysicalParticleContainer::SetTileFields (const WarpXParIter& pti, int lev,
+                                          const std::array<const MultiFab*, 6>& fp_fields,
+                                          const std::array<const MultiFab*, 6>& cp_fields,
+                                          TileFields& tile_fields)
+{
+    for (int i = 0; i < 6; ++i) {
+        tile_fields.fp[i] = &((*fp_fields[i])[pti]);
+        tile_fields.cp[i] = (cp_fields[i]) ? &((*cp_fields[i])[pti]) : nullptr;
+    }
+    tile_fields.cp_filtered = false;
+
+    // With particles.nci_corr_filter_on_level, MultiParticleContainer::Evolve
+    // passes fields that are already filtered
+    if (WarpX::use_fdtd_nci_corr && !WarpX::nci_corr_filter_on_level) {
+        filterTileFields(tile_fields.fp, tile_fields.filtered_fp, pti.tilebox(), lev);
+    }
+}
+
 void
 PhysicalParticleContainer::Evolve (int lev,
 				   const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
@@ -1093,25 +1153,13 @@ PhysicalParticleContainer::Evolve (int lev,
                                    Real t, Real dt)
 {
     BL_PROFILE("PPC::Evolve()");
-    BL_PROFILE_VAR_NS("PPC::Evolve::Copy", blp_copy);
-    BL_PROFILE_VAR_NS("PICSAR::FieldGather", blp_pxr_fg);
-    BL_PROFILE_VAR_NS("PICSAR::ParticlePush", blp_pxr_pp);
-    BL_PROFILE_VAR_NS("PPC::Evolve::partition", blp_partition);
-    
-    const std::array<Real,3>& dx = WarpX::CellSize(lev);
-    const std::array<Real,3>& cdx = WarpX::CellSize(std::max(lev-1,0));
-
-    const auto& mypc = WarpX::GetInstance().GetPartContainer();
-    const int nstencilz_fdtd_nci_corr = mypc.nstencilz_fdtd_nci_corr;
 
     BL_ASSERT(OnSameGrids(lev,jx));
 
-    MultiFab* cost = WarpX::getCosts(lev);
-
-    const iMultiFab* current_masks = WarpX::CurrentBufferMasks(lev);
-    const iMultiFab* gather_masks = WarpX::GatherBufferMasks(lev);
+    const std::array<const MultiFab*, 6> fp_fields {{&Ex, &Ey, &Ez, &Bx, &By, &Bz}};
+    const std::array<const MultiFab*, 6> cp_fields {{cEx, cEy, cEz, cBx, cBy, cBz}};
 
-    bool has_buffer = cEx || cjx;
+    PreEvolve(lev, dt);
 
 #ifdef _OPENMP
 #pragma omp parallel 
@@ -1123,388 +1171,262 @@ PhysicalParticleContainer::Evolve (int lev,
         int thread_num = 0;
 #endif
 
-        FArrayBox filtered_Ex, filtered_Ey, filtered_Ez;
-        FArrayBox filtered_Bx, filtered_By, filtered_Bz;
-        std::vector<bool> inexflag;
-        Vector<long> pid;
-        RealVector tmp;
-        ParticleVector particle_tmp;
+        TileFields tile_fields;
 
 	for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
 	{
-            Real wt = amrex::second();
+            SetTileFields(pti, lev, fp_fields, cp_fields, tile_fields);
+            EvolveTile(pti, tile_fields, jx, jy, jz, cjx, cjy, cjz, rho, crho,
+                       thread_num, lev, dt);
+        }
+    }
 
-	    const Box& box = pti.validbox();
+    PostEvolve(lev);
+}
 
-            auto& attribs = pti.GetAttribs();
+void
+PhysicalParticleContainer::PostEvolve (int lev)
+{
+    // Split particles
+    if (do_splitting){ SplitParticles(lev); }
+}
 
-            auto&  wp = attribs[PIdx::w];
-            auto& uxp = attribs[PIdx::ux];
-            auto& uyp = attribs[PIdx::uy];
-            auto& uzp = attribs[PIdx::uz];
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+void
+PhysicalParticleContainer::EvolveTile (WarpXParIter& pti, TileFields& tile_fields,
+                                       MultiFab& jx, MultiFab& jy, MultiFab& jz,
+                                       MultiFab* cjx, MultiFab* cjy, MultiFab* cjz,
+                                       MultiFab* rho, MultiFab* crho,
+                                       int thread_num, int lev, Real dt)
+{
+    BL_PROFILE_VAR_NS("PPC::Evolve::Copy", blp_copy);
+    BL_PROFILE_VAR_NS("PICSAR::FieldGather", blp_pxr_fg);
+    BL_PROFILE_VAR_NS("PICSAR::ParticlePush", blp_pxr_pp);
+    BL_PROFILE_VAR_NS("PPC::Evolve::partition", blp_partition);
+    BL_PROFILE_VAR_NS("PPC::Evolve::FusedLoop", blp_fused);
 
-            const long np = pti.numParticles();
+    MultiFab* cost = WarpX::getCosts(lev);
 
-	    // Data on the grid
-            FArrayBox const* exfab = &(Ex[pti]);
-            FArrayBox const* eyfab = &(Ey[pti]);
-            FArrayBox const* ezfab = &(Ez[pti]);
-            FArrayBox const* bxfab = &(Bx[pti]);
-            FArrayBox const* byfab = &(By[pti]);
-            FArrayBox const* bzfab = &(Bz[pti]);
-
-            if (WarpX::use_fdtd_nci_corr)
-            {
-#if (AMREX_SPACEDIM == 2)
-                const Box& tbox = amrex::grow(pti.tilebox(),{static_cast<int>(WarpX::nox),
-                            static_cast<int>(WarpX::noz)});
-#else
-                const Box& tbox = amrex::grow(pti.tilebox(),{static_cast<int>(WarpX::nox),
-                            static_cast<int>(WarpX::noy),
-                            static_cast<int>(WarpX::noz)});
-#endif
+    const iMultiFab* current_masks = WarpX::CurrentBufferMasks(lev);
+    const iMultiFab* gather_masks = WarpX::GatherBufferMasks(lev);
 
-                // both 2d and 3d
-                filtered_Ex.resize(amrex::convert(tbox,WarpX::Ex_nodal_flag));
-                WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_Ex),
-                                        BL_TO_FORTRAN_ANYD(filtered_Ex),
-                                        BL_TO_FORTRAN_ANYD(Ex[pti]),
-                                        mypc.fdtd_nci_stencilz_ex[lev].data(),
-                                        &nstencilz_fdtd_nci_corr);
-                exfab = &filtered_Ex;
-
-                filtered_Ez.resize(amrex::convert(tbox,WarpX::Ez_nodal_flag));
-                WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_Ez),
-                                        BL_TO_FORTRAN_ANYD(filtered_Ez),
-                                        BL_TO_FORTRAN_ANYD(Ez[pti]),
-                                        mypc.fdtd_nci_stencilz_by[lev].data(),
-                                        &nstencilz_fdtd_nci_corr);
-                ezfab = &filtered_Ez;
-
-                filtered_By.resize(amrex::convert(tbox,WarpX::By_nodal_flag));
-                WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_By),
-                                        BL_TO_FORTRAN_ANYD(filtered_By),
-                                        BL_TO_FORTRAN_ANYD(By[pti]),
-                                        mypc.fdtd_nci_stencilz_by[lev].data(),
-                                        &nstencilz_fdtd_nci_corr);
-                byfab = &filtered_By;
+    const bool has_coarse_fields = (tile_fields.cp[0] != nullptr);
+    const bool has_buffer = has_coarse_fields || cjx;
 
-#if (AMREX_SPACEDIM == 3)
-                filtered_Ey.resize(amrex::convert(tbox,WarpX::Ey_nodal_flag));
-                WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_Ey),
-                                        BL_TO_FORTRAN_ANYD(filtered_Ey),
-                                        BL_TO_FORTRAN_ANYD(Ey[pti]),
-                                        mypc.fdtd_nci_stencilz_ex[lev].data(),
-                                        &nstencilz_fdtd_nci_corr);
-                eyfab = &filtered_Ey;
-
-                filtered_Bx.resize(amrex::convert(tbox,WarpX::Bx_nodal_flag));
-                WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_Bx),
-                                        BL_TO_FORTRAN_ANYD(filtered_Bx),
-                                        BL_TO_FORTRAN_ANYD(Bx[pti]),
-                                        mypc.fdtd_nci_stencilz_by[lev].data(),
-                                        &nstencilz_fdtd_nci_corr);
-                bxfab = &filtered_Bx;
-
-                filtered_Bz.resize(amrex::convert(tbox,WarpX::Bz_nodal_flag));
-                WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_Bz),
-                                        BL_TO_FORTRAN_ANYD(filtered_Bz),
-                                        BL_TO_FORTRAN_ANYD(Bz[pti]),
-                                        mypc.fdtd_nci_stencilz_ex[lev].data(),
-                                        &nstencilz_fdtd_nci_corr);
-                bzfab = &filtered_Bz;
-#endif
-            }
+    Real wt = amrex::second();
 
-	    Exp.assign(np,0.0);
-	    Eyp.assign(np,0.0);
-	    Ezp.assign(np,0.0);
-	    Bxp.assign(np,WarpX::B_external[0]);
-	    Byp.assign(np,WarpX::B_external[1]);
-	    Bzp.assign(np,WarpX::B_external[2]);
+    // Temporaries allocated for this tile (e.g. in DepositCurrent)
+    ScratchArena::ThreadArena().reset();
 
-	    m_giv[thread_num].resize(np);
+    const Box& box = pti.validbox();
 
-            long nfine_current = np;
-            long nfine_gather = np;
-            if (has_buffer && !do_not_push)
-            {
-                BL_PROFILE_VAR_START(blp_partition);
-                inexflag.resize(np);
-                auto& aos = pti.GetArrayOfStructs();
-                // We need to partition the large buffer first
-                iMultiFab const* bmasks = (WarpX::n_field_gather_buffer >= WarpX::n_current_deposition_buffer) ?
-                    gather_masks : current_masks;
-                int i = 0;
-                const auto& msk = (*bmasks)[pti];
-                for (const auto& p : aos) {
-                    const IntVect& iv = Index(p, lev);
-                    inexflag[i++] = msk(iv);
-                }
+    auto& attribs = pti.GetAttribs();
 
-                pid.resize(np);
-                std::iota(pid.begin(), pid.end(), 0L);
+    auto&  wp = attribs[PIdx::w];
+    auto& uxp = attribs[PIdx::ux];
+    auto& uyp = attribs[PIdx::uy];
+    auto& uzp = attribs[PIdx::uz];
+    auto gathered_fields = GetGatheredFields(pti);
+    auto& Exp = *gathered_fields[GatheredFieldIdx::Ex];
+    auto& Eyp = *gathered_fields[GatheredFieldIdx::Ey];
+    auto& Ezp = *gathered_fields[GatheredFieldIdx::Ez];
+    auto& Bxp = *gathered_fields[GatheredFieldIdx::Bx];
+    auto& Byp = *gathered_fields[GatheredFieldIdx::By];
+    auto& Bzp = *gathered_fields[GatheredFieldIdx::Bz];
+
+    const long np = pti.numParticles();
+
+    // Data on the grid
+    const FArrayBox* exfab = tile_fields.fp[0];
+    const FArrayBox* eyfab = tile_fields.fp[1];
+    const FArrayBox* ezfab = tile_fields.fp[2];
+    const FArrayBox* bxfab = tile_fields.fp[3];
+    const FArrayBox* byfab = tile_fields.fp[4];
+    const FArrayBox* bzfab = tile_fields.fp[5];
+
+    long nfine_current = np;
+    long nfine_gather = np;
+    if (has_buffer && !do_not_push)
+    {
+        BL_PROFILE_VAR_START(blp_partition);
+        PartitionParticlesInBuffers(pti, lev, gather_masks, current_masks, thread_num,
+                                    nfine_gather, nfine_current);
+        if (deposit_on_main_grid && lev > 0) {
+            nfine_current = 0;
+        }
+        BL_PROFILE_VAR_STOP(blp_partition);
+    }
 
-                auto sep = std::stable_partition(pid.begin(), pid.end(),
-                                                 [&inexflag](long id) { return inexflag[id]; });
+    const long np_current = (cjx) ? nfine_current : np;
 
-                if (WarpX::n_current_deposition_buffer == WarpX::n_field_gather_buffer) {
-                    nfine_current = nfine_gather = std::distance(pid.begin(), sep);
-                } else if (sep != pid.end()) {
-                    int n_buf;
-                    if (bmasks == gather_masks) {
-                        nfine_gather = std::distance(pid.begin(), sep);
-                        bmasks = current_masks;
-                        n_buf = WarpX::n_current_deposition_buffer;
-                    } else {
-                        nfine_current = std::distance(pid.begin(), sep);
-                        bmasks = gather_masks;
-                        n_buf = WarpX::n_field_gather_buffer;
-                    }
-                    if (n_buf > 0)
-                    {
-                        const auto& msk2 = (*bmasks)[pti];
-                        for (auto it = sep; it != pid.end(); ++it) {
-                            const long id = *it;
-                            const IntVect& iv = Index(aos[id], lev);
-                            inexflag[id] = msk2(iv);
-                        }
+    // The fused kernel handles the common case where all the particles
+    // of the tile gather from and deposit to the fine patch.
+    const bool use_fused_loop = UseFusedParticleLoop() && !do_not_push && !rho
+        && ((has_coarse_fields) ? nfine_gather : np) == np && np_current == np;
+    if (use_fused_loop)
+    {
+        BL_PROFILE_VAR_START(blp_fused);
+        FusedGatherPushDeposit(pti, *exfab, *eyfab, *ezfab, *bxfab, *byfab, *bzfab,
+                               jx, jy, jz, thread_num, lev, dt);
+        BL_PROFILE_VAR_STOP(blp_fused);
+    }
+    else
+    {
+        Exp.assign(np,0.0);
+        Eyp.assign(np,0.0);
+        Ezp.assign(np,0.0);
+        Bxp.assign(np,WarpX::B_external[0]);
+        Byp.assign(np,WarpX::B_external[1]);
+        Bzp.assign(np,WarpX::B_external[2]);
 
-                        auto sep2 = std::stable_partition(sep, pid.end(),
-                                                          [&inexflag](long id) {return inexflag[id];});
-                        if (bmasks == gather_masks) {
-                            nfine_gather = std::distance(pid.begin(), sep2);
-                        } else {
-                            nfine_current = std::distance(pid.begin(), sep2);
-                        }
-                    }
-                }
+        m_giv[thread_num].resize(np);
 
-                if (deposit_on_main_grid && lev > 0) {
-                    nfine_current = 0;
-                }
+        //
+        // copy data from particle container to temp arrays
+        //
+        BL_PROFILE_VAR_START(blp_copy);
+        pti.GetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
+        BL_PROFILE_VAR_STOP(blp_copy);
 
-                if (nfine_current != np || nfine_gather != np)
-                {
-                    particle_tmp.resize(np);
-                    for (long ip = 0; ip < np; ++ip) {
-                        particle_tmp[ip] = aos[pid[ip]];
-                    }
-                    std::swap(aos(), particle_tmp);
+        if (rho) DepositCharge(pti, wp, rho, crho, 0, np_current, np, thread_num, lev);
 
-                    tmp.resize(np);
-                    for (long ip = 0; ip < np; ++ip) {
-                        tmp[ip] = wp[pid[ip]];
-                    }
-                    std::swap(wp, tmp);
+        if (! do_not_push)
+        {
+            //
+            // Field Gather of Aux Data (i.e., the full solution)
+            //
+            const long np_gather = (has_coarse_fields) ? nfine_gather : np;
 
-                    for (long ip = 0; ip < np; ++ip) {
-                        tmp[ip] = uxp[pid[ip]];
-                    }
-                    std::swap(uxp, tmp);
+            BL_PROFILE_VAR_START(blp_pxr_fg);
 
-                    for (long ip = 0; ip < np; ++ip) {
-                        tmp[ip] = uyp[pid[ip]];
-                    }
-                    std::swap(uyp, tmp);
+            GatherFields(m_xp[thread_num].dataPtr(),
+                         m_yp[thread_num].dataPtr(),
+                         m_zp[thread_num].dataPtr(),
+                         Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+                         Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), np_gather,
+                         *exfab, *eyfab, *ezfab, *bxfab, *byfab, *bzfab,
+                         box, lev, WarpX::l_lower_order_in_v);
 
-                    for (long ip = 0; ip < np; ++ip) {
-                        tmp[ip] = uzp[pid[ip]];
-                    }
-                    std::swap(uzp, tmp);
+            if (np_gather < np)
+            {
+                const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
+                const Box& cbox = amrex::coarsen(box,ref_ratio);
+
+                // The coarse-patch fields are only filtered for the tiles
+                // that have particles in the gather buffers, and only once
+                // for all the species
+                if (WarpX::use_fdtd_nci_corr && !WarpX::nci_corr_filter_on_level
+                    && !tile_fields.cp_filtered)
+                {
+                    filterTileFields(tile_fields.cp, tile_fields.filtered_cp, cbox, lev-1);
+                    tile_fields.cp_filtered = true;
                 }
-                BL_PROFILE_VAR_STOP(blp_partition);
+
+                const long ncrse = np - nfine_gather;
+                GatherFields(m_xp[thread_num].dataPtr()+nfine_gather,
+                             m_yp[thread_num].dataPtr()+nfine_gather,
+                             m_zp[thread_num].dataPtr()+nfine_gather,
+                             Exp.dataPtr()+nfine_gather, Eyp.dataPtr()+nfine_gather,
+                             Ezp.dataPtr()+nfine_gather, Bxp.dataPtr()+nfine_gather,
+                             Byp.dataPtr()+nfine_gather, Bzp.dataPtr()+nfine_gather, ncrse,
+                             *tile_fields.cp[0], *tile_fields.cp[1], *tile_fields.cp[2],
+                             *tile_fields.cp[3], *tile_fields.cp[4], *tile_fields.cp[5],
+                             cbox, lev-1, WarpX::l_lower_order_in_v);
             }
 
-            const long np_current = (cjx) ? nfine_current : np;
-            
-	    //
-	    // copy data from particle container to temp arrays
-	    //
-	    BL_PROFILE_VAR_START(blp_copy);
-            pti.GetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
-	    BL_PROFILE_VAR_STOP(blp_copy);
+            BL_PROFILE_VAR_STOP(blp_pxr_fg);
 
-            if (rho) DepositCharge(pti, wp, rho, crho, 0, np_current, np, thread_num, lev);
-            
-            if (! do_not_push)
-            {
-                //
-                // Field Gather of Aux Data (i.e., the full solution)
-                //
-                const int ll4symtry          = false;
-                long lvect_fieldgathe = 64;
-
-                const std::array<Real,3>& xyzmin_grid = WarpX::LowerCorner(box, lev);
-                const int* ixyzmin_grid = box.loVect();
-                
-                const long np_gather = (cEx) ? nfine_gather : np;
-
-                BL_PROFILE_VAR_START(blp_pxr_fg);
-
-                warpx_geteb_energy_conserving(
-                    &np_gather,
-                    m_xp[thread_num].dataPtr(),
-                    m_yp[thread_num].dataPtr(),
-                    m_zp[thread_num].dataPtr(),
-                    Exp.dataPtr(),Eyp.dataPtr(),Ezp.dataPtr(),
-                    Bxp.dataPtr(),Byp.dataPtr(),Bzp.dataPtr(),
-                    ixyzmin_grid,
-                    &xyzmin_grid[0], &xyzmin_grid[1], &xyzmin_grid[2],
-                    &dx[0], &dx[1], &dx[2],
-                    &WarpX::nox, &WarpX::noy, &WarpX::noz,
-                    BL_TO_FORTRAN_ANYD(*exfab),
-                    BL_TO_FORTRAN_ANYD(*eyfab),
-                    BL_TO_FORTRAN_ANYD(*ezfab),
-                    BL_TO_FORTRAN_ANYD(*bxfab),
-                    BL_TO_FORTRAN_ANYD(*byfab),
-                    BL_TO_FORTRAN_ANYD(*bzfab),
-                    &ll4symtry, &WarpX::l_lower_order_in_v, &WarpX::do_nodal,
-                    &lvect_fieldgathe, &WarpX::field_gathering_algo);
-
-                if (np_gather < np)
-                {
-                    const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
-                    const Box& cbox = amrex::coarsen(box,ref_ratio);
-                    const std::array<Real,3>& cxyzmin_grid = WarpX::LowerCorner(cbox, lev-1);
-                    const int* cixyzmin_grid = cbox.loVect();
-
-                    const FArrayBox* cexfab = &(*cEx)[pti];
-                    const FArrayBox* ceyfab = &(*cEy)[pti];
-                    const FArrayBox* cezfab = &(*cEz)[pti];
-                    const FArrayBox* cbxfab = &(*cBx)[pti];
-                    const FArrayBox* cbyfab = &(*cBy)[pti];
-                    const FArrayBox* cbzfab = &(*cBz)[pti];
-
-                    if (WarpX::use_fdtd_nci_corr)
-                    {
-#if (AMREX_SPACEDIM == 2)
-                        const Box& tbox = amrex::grow(cbox,{static_cast<int>(WarpX::nox),
-                                    static_cast<int>(WarpX::noz)});
-#else
-                        const Box& tbox = amrex::grow(cbox,{static_cast<int>(WarpX::nox),
-                                    static_cast<int>(WarpX::noy),
-                                    static_cast<int>(WarpX::noz)});
-#endif
+            //
+            // Particle Push
+            //
+            BL_PROFILE_VAR_START(blp_pxr_pp);
+            PushPX(pti, m_xp[thread_num], m_yp[thread_num], m_zp[thread_num], 
+                   m_giv[thread_num], dt);
+            BL_PROFILE_VAR_STOP(blp_pxr_pp);
 
-                        // both 2d and 3d
-                        filtered_Ex.resize(amrex::convert(tbox,WarpX::Ex_nodal_flag));
-                        WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_Ex),
-                                                BL_TO_FORTRAN_ANYD(filtered_Ex),
-                                                BL_TO_FORTRAN_ANYD((*cEx)[pti]),
-                                                mypc.fdtd_nci_stencilz_ex[lev-1].data(),
-                                                &nstencilz_fdtd_nci_corr);
-                        cexfab = &filtered_Ex;
-
-                        filtered_Ez.resize(amrex::convert(tbox,WarpX::Ez_nodal_flag));
-                        WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_Ez),
-                                                BL_TO_FORTRAN_ANYD(filtered_Ez),
-                                                BL_TO_FORTRAN_ANYD((*cEz)[pti]),
-                                                mypc.fdtd_nci_stencilz_by[lev-1].data(),
-                                                &nstencilz_fdtd_nci_corr);
-                        cezfab = &filtered_Ez;
-                        filtered_By.resize(amrex::convert(tbox,WarpX::By_nodal_flag));
-                        WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_By),
-                                                BL_TO_FORTRAN_ANYD(filtered_By),
-                                                BL_TO_FORTRAN_ANYD((*cBy)[pti]),
-                                                mypc.fdtd_nci_stencilz_by[lev-1].data(),
-                                                &nstencilz_fdtd_nci_corr);
-                        cbyfab = &filtered_By;
+            //
+            // Current Deposition
+            //
+            DepositCurrent(pti, wp, uxp, uyp, uzp, jx, jy, jz,
+                           cjx, cjy, cjz, np_current, np, thread_num, lev, dt);
 
-#if (AMREX_SPACEDIM == 3)
-                        filtered_Ey.resize(amrex::convert(tbox,WarpX::Ey_nodal_flag));
-                        WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_Ey),
-                                                BL_TO_FORTRAN_ANYD(filtered_Ey),
-                                                BL_TO_FORTRAN_ANYD((*cEy)[pti]),
-                                                mypc.fdtd_nci_stencilz_ex[lev-1].data(),
-                                                &nstencilz_fdtd_nci_corr);
-                        ceyfab = &filtered_Ey;
-                        
-                        filtered_Bx.resize(amrex::convert(tbox,WarpX::Bx_nodal_flag));
-                        WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_Bx),
-                                                BL_TO_FORTRAN_ANYD(filtered_Bx),
-                                                BL_TO_FORTRAN_ANYD((*cBx)[pti]),
-                                                mypc.fdtd_nci_stencilz_by[lev-1].data(),
-                                                &nstencilz_fdtd_nci_corr);
-                        cbxfab = &filtered_Bx;
-                        
-                        filtered_Bz.resize(amrex::convert(tbox,WarpX::Bz_nodal_flag));
-                        WRPX_PXR_GODFREY_FILTER(BL_TO_FORTRAN_BOX(filtered_Bz),
-                                                BL_TO_FORTRAN_ANYD(filtered_Bz),
-                                                BL_TO_FORTRAN_ANYD((*cBz)[pti]),
-                                                mypc.fdtd_nci_stencilz_ex[lev-1].data(),
-                                                &nstencilz_fdtd_nci_corr);
-                        cbzfab = &filtered_Bz;
-#endif
-                    }
-                    
-                    long ncrse = np - nfine_gather;
-                    warpx_geteb_energy_conserving(
-                        &ncrse,
-                        m_xp[thread_num].dataPtr()+nfine_gather,
-                        m_yp[thread_num].dataPtr()+nfine_gather,
-                        m_zp[thread_num].dataPtr()+nfine_gather,
-                        Exp.dataPtr()+nfine_gather, Eyp.dataPtr()+nfine_gather, Ezp.dataPtr()+nfine_gather,
-                        Bxp.dataPtr()+nfine_gather, Byp.dataPtr()+nfine_gather, Bzp.dataPtr()+nfine_gather,
-                        cixyzmin_grid,
-                        &cxyzmin_grid[0], &cxyzmin_grid[1], &cxyzmin_grid[2],
-                        &cdx[0], &cdx[1], &cdx[2],
-                        &WarpX::nox, &WarpX::noy, &WarpX::noz,
-                        BL_TO_FORTRAN_ANYD(*cexfab),
-                        BL_TO_FORTRAN_ANYD(*ceyfab),
-                        BL_TO_FORTRAN_ANYD(*cezfab),
-                        BL_TO_FORTRAN_ANYD(*cbxfab),
-                        BL_TO_FORTRAN_ANYD(*cbyfab),
-                        BL_TO_FORTRAN_ANYD(*cbzfab),
-                        &ll4symtry, &WarpX::l_lower_order_in_v, &WarpX::do_nodal,
-                        &lvect_fieldgathe, &WarpX::field_gathering_algo);
-                }
+            //
+            // copy particle data back
+            //
+            BL_PROFILE_VAR_START(blp_copy);
+            pti.SetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
+            BL_PROFILE_VAR_STOP(blp_copy);
+        }
 
-                BL_PROFILE_VAR_STOP(blp_pxr_fg);
-
-                //
-                // Particle Push
-                //
-                BL_PROFILE_VAR_START(blp_pxr_pp);
-                PushPX(pti, m_xp[thread_num], m_yp[thread_num], m_zp[thread_num], 
-                       m_giv[thread_num], dt);
-                BL_PROFILE_VAR_STOP(blp_pxr_pp);
-
-                //
-                // Current Deposition
-                //
-                DepositCurrent(pti, wp, uxp, uyp, uzp, jx, jy, jz,
-                               cjx, cjy, cjz, np_current, np, thread_num, lev, dt);
-  
-                //
-                // copy particle data back
-                //
-                BL_PROFILE_VAR_START(blp_copy);
-                pti.SetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
-                BL_PROFILE_VAR_STOP(blp_copy);
-            }
-            
-            if (rho) DepositCharge(pti, wp, rho, crho, 1, np_current, np, thread_num, lev);
+        if (rho) DepositCharge(pti, wp, rho, crho, 1, np_current, np, thread_num, lev);
+    }
 
-            if (cost) {
-                const Box& tbx = pti.tilebox();
-                wt = (amrex::second() - wt) / tbx.d_numPts();
-                FArrayBox* costfab = cost->fabPtr(pti);
-                AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( tbx, work_box,
-                {
-                    costfab->plus(wt, work_box);
-                });
-            }
-        }
+    if (cost) {
+        const Box& tbx = pti.tilebox();
+        wt = (amrex::second() - wt) / tbx.d_numPts();
+        FArrayBox* costfab = cost->fabPtr(pti);
+        AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( tbx, work_box,
+        {
+            costfab->plus(wt, work_box);
+        });
     }
-    // Split particles
-    if (do_splitting){ SplitParticles(lev); }
+}
+
+void
+PhysicalParticleContainer::PartitionParticlesInBuffers (WarpXParIter& pti, int lev,
+                                                        const iMultiFab* gather_masks,
+                                                        const iMultiFab* current_masks,
+                                                        int thread_num,
+                                                        long& nfine_gather, long& nfine_current)
+{
+    const long np = pti.numParticles();
+    const auto& aos = pti.GetArrayOfStructs();
+
+    // The particles are sorted in three buckets (see BufferBuckets)
+    const bool gather_is_larger = (WarpX::n_field_gather_buffer >= WarpX::n_current_deposition_buffer);
+    const int n_small_buf = (gather_is_larger) ? WarpX::n_current_deposition_buffer
+                                               : WarpX::n_field_gather_buffer;
+    const bool use_small_masks = (n_small_buf > 0) &&
+        (WarpX::n_field_gather_buffer != WarpX::n_current_deposition_buffer);
+    const BufferBuckets buckets(gather_masks, current_masks);
+
+    auto& scratch = m_reorder_scratch[thread_num];
+    auto& bucket = scratch.keys;
+    bucket.resize(np);
+
+    long nbucket[3] = {0, 0, 0};
+    bool is_partitioned = true;
+    for (long ip = 0; ip < np; ++ip) {
+        const long b = buckets(pti, Index(aos[ip], lev));
+        bucket[ip] = b;
+        ++nbucket[b];
+        if (ip > 0 && b < bucket[ip-1]) is_partitioned = false;
+    }
+
+    const long nfine_large = nbucket[0];
+    const long nfine_small = (use_small_masks) ? nbucket[0] + nbucket[1] : np;
+    if (WarpX::n_field_gather_buffer == WarpX::n_current_deposition_buffer) {
+        nfine_gather = nfine_current = nfine_large;
+    } else if (gather_is_larger) {
+        nfine_gather = nfine_large;
+        nfine_current = nfine_small;
+    } else {
+        nfine_current = nfine_large;
+        nfine_gather = nfine_small;
+    }
+
+    // In most steps, the particles are still in the same buckets as in the
+    // previous step, and there is nothing to move.
+    if (is_partitioned) return;
+
+    // Stable partition
+    long offsets[3] = {0, nbucket[0], nbucket[0] + nbucket[1]};
+    auto& perm = scratch.perm;
+    perm.resize(np);
+    for (long ip = 0; ip < np; ++ip) {
+        perm[offsets[bucket[ip]]++] = ip;
+    }
+
+    ReorderParticles(pti, perm, scratch);
 }
 
 // Loop over all particles in the particle container and
@@ -1675,12 +1597,13 @@ PhysicalParticleContainer::PushPX(WarpXParIter& pti,
     auto& uxp = attribs[PIdx::ux];
     auto& uyp = attribs[PIdx::uy];
     auto& uzp = attribs[PIdx::uz];
-    auto& Exp = attribs[PIdx::Ex];
-    auto& Eyp = attribs[PIdx::Ey];
-    auto& Ezp = attribs[PIdx::Ez];
-    auto& Bxp = attribs[PIdx::Bx];
-    auto& Byp = attribs[PIdx::By];
-    auto& Bzp = attribs[PIdx::Bz];
+    auto gathered_fields = GetGatheredFields(pti);
+    auto& Exp = *gathered_fields[GatheredFieldIdx::Ex];
+    auto& Eyp = *gathered_fields[GatheredFieldIdx::Ey];
+    auto& Ezp = *gathered_fields[GatheredFieldIdx::Ez];
+    auto& Bxp = *gathered_fields[GatheredFieldIdx::Bx];
+    auto& Byp = *gathered_fields[GatheredFieldIdx::By];
+    auto& Bzp = *gathered_fields[GatheredFieldIdx::Bz];
     const long np  = pti.numParticles();
 
     if (WarpX::do_boosted_frame_diagnostic && WarpX::do_boosted_frame_particles)
@@ -1711,6 +1634,245 @@ PhysicalParticleContainer::PushPX(WarpXParIter& pti,
 
 }
 
+bool
+PhysicalParticleContainer::UseFusedParticleLoop () const
+{
+    return WarpX::fused_particle_loop;
+}
+
+void
+PhysicalParticleContainer::FusedGatherPushDeposit (WarpXParIter& pti,
+                                                   const FArrayBox& exfab,
+                                                   const FArrayBox& eyfab,
+                                                   const FArrayBox& ezfab,
+                                                   const FArrayBox& bxfab,
+                                                   const FArrayBox& byfab,
+                                                   const FArrayBox& bzfab,
+                                                   MultiFab& jx, MultiFab& jy, MultiFab& jz,
+                                                   int thread_num, int lev, Real dt)
+{
+    BL_PROFILE_VAR_NS("PPC::Evolve::Accumulate", blp_accumulate);
+
+    // WarpX assumes the same number of guard cells for Jx, Jy, Jz
+    const int ngJ = jx.nGrow();
+
+    Box tbx = amrex::grow(amrex::convert(pti.tilebox(), WarpX::jx_nodal_flag), ngJ);
+    Box tby = amrex::grow(amrex::convert(pti.tilebox(), WarpX::jy_nodal_flag), ngJ);
+    Box tbz = amrex::grow(amrex::convert(pti.tilebox(), WarpX::jz_nodal_flag), ngJ);
+
+    local_jx[thread_num].resize(tbx);
+    local_jy[thread_num].resize(tby);
+    local_jz[thread_num].resize(tbz);
+
+    local_jx[thread_num].setVal(0.0);
+    local_jy[thread_num].setVal(0.0);
+    local_jz[thread_num].setVal(0.0);
+
+    // Dispatch once per tile to the kernel specialized for the shape
+    // order and the staggering of the fields.
+    const bool lower_in_v = WarpX::l_lower_order_in_v && !WarpX::do_nodal;
+
+#define WARPX_FUSED_KERNEL(ORDER)                                       \
+    if (WarpX::do_nodal) {                                              \
+        FusedGatherPushDepositKernel<ORDER,0,1>(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab, \
+            local_jx[thread_num], local_jy[thread_num], local_jz[thread_num], lev, dt); \
+    } else if (lower_in_v) {                                            \
+        FusedGatherPushDepositKernel<ORDER,1,0>(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab, \
+            local_jx[thread_num], local_jy[thread_num], local_jz[thread_num], lev, dt); \
+    } else {                                                            \
+        FusedGatherPushDepositKernel<ORDER,0,0>(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab, \
+            local_jx[thread_num], local_jy[thread_num], local_jz[thread_num], lev, dt); \
+    }
+
+    // The kernels use the same shape order in all directions: this is
+    // checked in WarpX::ReadParameters (interpolation.nox, noy and noz)
+    AMREX_ASSERT(WarpX::nox == WarpX::noy && WarpX::nox == WarpX::noz);
+    if        (WarpX::nox == 1) {
+        WARPX_FUSED_KERNEL(1);
+    } else if (WarpX::nox == 2) {
+        WARPX_FUSED_KERNEL(2);
+    } else if (WarpX::nox == 3) {
+        WARPX_FUSED_KERNEL(3);
+    } else {
+        amrex::Abort("algo.fused_particle_loop only supports interpolation.nox = 1, 2 or 3");
+    }
+
+#undef WARPX_FUSED_KERNEL
+
+    BL_PROFILE_VAR_START(blp_accumulate);
+
+    jx[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, 1);
+    jy[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, 1);
+    jz[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, 1);
+
+    BL_PROFILE_VAR_STOP(blp_accumulate);
+}
+
+template <int depos_order, int lower_in_v, int nodal>
+void
+PhysicalParticleContainer::FusedGatherPushDepositKernel (WarpXParIter& pti,
+                                                         const FArrayBox& exfab,
+                                                         const FArrayBox& eyfab,
+                                                         const FArrayBox& ezfab,
+                                                         const FArrayBox& bxfab,
+                                                         const FArrayBox& byfab,
+                                                         const FArrayBox& bzfab,
+                                                         FArrayBox& jxfab,
+                                                         FArrayBox& jyfab,
+                                                         FArrayBox& jzfab,
+                                                         int lev, Real dt)
+{
+    // Number of particles processed together. The gathered fields and
+    // Lorentz factors of a block stay in L1 cache between the gather,
+    // the push and the deposition.
+    constexpr long block_size = 256;
+
+    const Box& box = pti.validbox();
+    const std::array<Real,3>& dx = WarpX::CellSize(lev);
+    const std::array<Real,3>& xyzmin = WarpX::LowerCorner(box, lev);
+    // As in DepositCurrent, the current is deposited on the grid at t+dt/2
+    // (which differs from the grid at t with the Galilean solver)
+    const std::array<Real,3>& xyzmin_j = WarpX::LowerCorner(box, lev, 0.5*dt);
+    const Dim3 lo = amrex::lbound(box);
+    const Real dxi = 1.0/dx[0];
+    const Real dyi = 1.0/dx[1];
+    const Real dzi = 1.0/dx[2];
+
+    const auto ex_arr = exfab.array();
+    const auto ey_arr = eyfab.array();
+    const auto ez_arr = ezfab.array();
+    const auto bx_arr = bxfab.array();
+    const auto by_arr = byfab.array();
+    const auto bz_arr = bzfab.array();
+    const auto jx_arr = jxfab.array();
+    const auto jy_arr = jyfab.array();
+    const auto jz_arr = jzfab.array();
+
+    auto& attribs = pti.GetAttribs();
+    const Real* AMREX_RESTRICT wp = attribs[PIdx::w].dataPtr();
+    Real* AMREX_RESTRICT uxp = attribs[PIdx::ux].dataPtr();
+    Real* AMREX_RESTRICT uyp = attribs[PIdx::uy].dataPtr();
+    Real* AMREX_RESTRICT uzp = attribs[PIdx::uz].dataPtr();
+    ParticleType* AMREX_RESTRICT pstruct = pti.GetArrayOfStructs()().dataPtr();
+    const long np = pti.numParticles();
+
+    const bool save_old = WarpX::do_boosted_frame_diagnostic && WarpX::do_boosted_frame_particles;
+    Real* xpold  = (save_old) ? pti.GetAttribs(particle_comps["xold"]).dataPtr() : nullptr;
+    Real* ypold  = (save_old) ? pti.GetAttribs(particle_comps["yold"]).dataPtr() : nullptr;
+    Real* zpold  = (save_old) ? pti.GetAttribs(particle_comps["zold"]).dataPtr() : nullptr;
+    Real* uxpold = (save_old) ? pti.GetAttribs(particle_comps["uxold"]).dataPtr() : nullptr;
+    Real* uypold = (save_old) ? pti.GetAttribs(particle_comps["uyold"]).dataPtr() : nullptr;
+    Real* uzpold = (save_old) ? pti.GetAttribs(particle_comps["uzold"]).dataPtr() : nullptr;
+
+    const bool use_vay = (WarpX::particle_pusher_algo == 1);
+    const bool use_esirkepov = (WarpX::current_deposition_algo < 2) && !nodal;
+    const Real q = this->charge;
+    const Real m = this->mass;
+    const Real bx_ext = WarpX::B_external[0];
+    const Real by_ext = WarpX::B_external[1];
+    const Real bz_ext = WarpX::B_external[2];
+
+    Real Exp[block_size], Eyp[block_size], Ezp[block_size];
+    Real Bxp[block_size], Byp[block_size], Bzp[block_size];
+    Real gaminv[block_size];
+
+    for (long ib = 0; ib < np; ib += block_size)
+    {
+        const long nb = std::min(block_size, np-ib);
+        ParticleType* AMREX_RESTRICT p = pstruct + ib;
+
+        //
+        // Field gather
+        //
+        for (long i = 0; i < nb; ++i)
+        {
+#if (AMREX_SPACEDIM == 3)
+            const Real xp = p[i].pos(0);
+            const Real yp = p[i].pos(1);
+            const Real zp = p[i].pos(2);
+#else
+            const Real xp = p[i].pos(0);
+            const Real yp = 0.;
+            const Real zp = p[i].pos(1);
+#endif
+            Exp[i] = 0.;
+            Eyp[i] = 0.;
+            Ezp[i] = 0.;
+            Bxp[i] = bx_ext;
+            Byp[i] = by_ext;
+            Bzp[i] = bz_ext;
+            doGatherShapeN<depos_order,lower_in_v,nodal>(xp, yp, zp,
+                Exp[i], Eyp[i], Ezp[i], Bxp[i], Byp[i], Bzp[i],
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                dxi, dyi, dzi, xyzmin[0], xyzmin[1], xyzmin[2], lo);
+        }
+
+        //
+        // Particle push
+        //
+        for (long i = 0; i < nb; ++i)
+        {
+            const long ip = ib + i;
+#if (AMREX_SPACEDIM == 3)
+            Real& xp = p[i].pos(0);
+            Real& yp = p[i].pos(1);
+            Real& zp = p[i].pos(2);
+#else
+            Real& xp = p[i].pos(0);
+            Real yp = 0.;
+            Real& zp = p[i].pos(1);
+#endif
+            if (save_old) {
+                xpold[ip] = xp;
+                ypold[ip] = yp;
+                zpold[ip] = zp;
+                uxpold[ip] = uxp[ip];
+                uypold[ip] = uyp[ip];
+                uzpold[ip] = uzp[ip];
+            }
+            if (use_vay) {
+                UpdateMomentumVay(uxp[ip], uyp[ip], uzp[ip], gaminv[i],
+                                  Exp[i], Eyp[i], Ezp[i], Bxp[i], Byp[i], Bzp[i], q, m, dt);
+            } else {
+                UpdateMomentumBoris(uxp[ip], uyp[ip], uzp[ip], gaminv[i],
+                                    Exp[i], Eyp[i], Ezp[i], Bxp[i], Byp[i], Bzp[i], q, m, dt);
+            }
+            UpdatePosition(xp, yp, zp, uxp[ip], uyp[ip], uzp[ip], gaminv[i], dt);
+        }
+
+        //
+        // Current deposition
+        //
+        for (long i = 0; i < nb; ++i)
+        {
+            const long ip = ib + i;
+#if (AMREX_SPACEDIM == 3)
+            const Real xp = p[i].pos(0);
+            const Real yp = p[i].pos(1);
+            const Real zp = p[i].pos(2);
+#else
+            const Real xp = p[i].pos(0);
+            const Real yp = 0.;
+            const Real zp = p[i].pos(1);
+#endif
+            const Real wq = q*wp[ip];
+            const Real vx = uxp[ip]*gaminv[i];
+            const Real vy = uyp[ip]*gaminv[i];
+            const Real vz = uzp[ip]*gaminv[i];
+            if (use_esirkepov) {
+                doEsirkepovDepositionShapeN<depos_order>(xp, yp, zp, wq, vx, vy, vz,
+                    jx_arr, jy_arr, jz_arr, dt, dxi, dyi, dzi,
+                    xyzmin_j[0], xyzmin_j[1], xyzmin_j[2], lo);
+            } else {
+                // As in DepositCurrent, nodal currents are deposited at t+dt
+                doDirectDepositionShapeN<depos_order,nodal>(xp, yp, zp, wq, vx, vy, vz,
+                    jx_arr, jy_arr, jz_arr, (nodal) ? 0. : dt, dxi, dyi, dzi,
+                    xyzmin_j[0], xyzmin_j[1], xyzmin_j[2], lo);
+            }
+        }
+    }
+}
+
 void
 PhysicalParticleContainer::PushP (int lev, Real dt,
                                   const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
@@ -1720,8 +1882,6 @@ PhysicalParticleContainer::PushP (int lev, Real dt,
 
     if (do_not_push) return;
 
-    const std::array<Real,3>& dx = WarpX::CellSize(lev);
-
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -1740,12 +1900,13 @@ PhysicalParticleContainer::PushP (int lev, Real dt,
             auto& uxp = attribs[PIdx::ux];
             auto& uyp = attribs[PIdx::uy];
             auto& uzp = attribs[PIdx::uz];
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+            auto gathered_fields = GetGatheredFields(pti);
+            auto& Exp = *gathered_fields[GatheredFieldIdx::Ex];
+            auto& Eyp = *gathered_fields[GatheredFieldIdx::Ey];
+            auto& Ezp = *gathered_fields[GatheredFieldIdx::Ez];
+            auto& Bxp = *gathered_fields[GatheredFieldIdx::Bx];
+            auto& Byp = *gathered_fields[GatheredFieldIdx::By];
+            auto& Bzp = *gathered_fields[GatheredFieldIdx::Bz];
 
             const long np = pti.numParticles();
 
@@ -1771,31 +1932,13 @@ PhysicalParticleContainer::PushP (int lev, Real dt,
 	    //
             pti.GetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
 
-            const std::array<Real,3>& xyzmin_grid = WarpX::LowerCorner(box, lev);
-            const int* ixyzmin_grid = box.loVect();
-
-            const int ll4symtry          = false;
-            long lvect_fieldgathe = 64;
-
-            warpx_geteb_energy_conserving(
-                &np,
-                m_xp[thread_num].dataPtr(),
-                m_yp[thread_num].dataPtr(),
-                m_zp[thread_num].dataPtr(),
-                Exp.dataPtr(),Eyp.dataPtr(),Ezp.dataPtr(),
-                Bxp.dataPtr(),Byp.dataPtr(),Bzp.dataPtr(),
-                ixyzmin_grid,
-                &xyzmin_grid[0], &xyzmin_grid[1], &xyzmin_grid[2],
-                &dx[0], &dx[1], &dx[2],
-                &WarpX::nox, &WarpX::noy, &WarpX::noz,
-                BL_TO_FORTRAN_ANYD(exfab),
-                BL_TO_FORTRAN_ANYD(eyfab),
-                BL_TO_FORTRAN_ANYD(ezfab),
-                BL_TO_FORTRAN_ANYD(bxfab),
-                BL_TO_FORTRAN_ANYD(byfab),
-                BL_TO_FORTRAN_ANYD(bzfab),
-                &ll4symtry, &WarpX::l_lower_order_in_v, &WarpX::do_nodal,
-                &lvect_fieldgathe, &WarpX::field_gathering_algo);
+            GatherFields(m_xp[thread_num].dataPtr(),
+                         m_yp[thread_num].dataPtr(),
+                         m_zp[thread_num].dataPtr(),
+                         Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+                         Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), np,
+                         exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                         box, lev, WarpX::l_lower_order_in_v);
 
             warpx_particle_pusher_momenta(&np,
                                           m_xp[thread_num].dataPtr(),
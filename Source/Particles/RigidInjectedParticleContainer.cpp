@@ -10,6 +10,7 @@
 #include <WarpX_f.H>
 #include <WarpX.H>
 #include <WarpXConst.H>
+#include <ScratchArena.H>
 
 using namespace amrex;
 
@@ -217,12 +218,13 @@ RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
     auto& uxp = attribs[PIdx::ux];
     auto& uyp = attribs[PIdx::uy];
     auto& uzp = attribs[PIdx::uz];
-    auto& Exp = attribs[PIdx::Ex];
-    auto& Eyp = attribs[PIdx::Ey];
-    auto& Ezp = attribs[PIdx::Ez];
-    auto& Bxp = attribs[PIdx::Bx];
-    auto& Byp = attribs[PIdx::By];
-    auto& Bzp = attribs[PIdx::Bz];
+    auto gathered_fields = GetGatheredFields(pti);
+    auto& Exp = *gathered_fields[GatheredFieldIdx::Ex];
+    auto& Eyp = *gathered_fields[GatheredFieldIdx::Ey];
+    auto& Ezp = *gathered_fields[GatheredFieldIdx::Ez];
+    auto& Bxp = *gathered_fields[GatheredFieldIdx::Bx];
+    auto& Byp = *gathered_fields[GatheredFieldIdx::By];
+    auto& Bzp = *gathered_fields[GatheredFieldIdx::Bz];
     const long np  = pti.numParticles();
 
     if (WarpX::do_boosted_frame_diagnostic && WarpX::do_boosted_frame_particles)
@@ -241,16 +243,27 @@ RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
     }
 
     // Save the position and momenta, making copies
-    Cuda::ManagedDeviceVector<Real> xp_save, yp_save, zp_save;
-    RealVector uxp_save, uyp_save, uzp_save;
+    Real* xp_save = nullptr;
+    Real* yp_save = nullptr;
+    Real* zp_save = nullptr;
+    Real* uxp_save = nullptr;
+    Real* uyp_save = nullptr;
+    Real* uzp_save = nullptr;
 
     if (!done_injecting_lev) {
-        xp_save = xp;
-        yp_save = yp;
-        zp_save = zp;
-        uxp_save = uxp;
-        uyp_save = uyp;
-        uzp_save = uzp;
+        ScratchArena& arena = ScratchArena::ThreadArena();
+        xp_save = arena.alloc<Real>(np);
+        yp_save = arena.alloc<Real>(np);
+        zp_save = arena.alloc<Real>(np);
+        uxp_save = arena.alloc<Real>(np);
+        uyp_save = arena.alloc<Real>(np);
+        uzp_save = arena.alloc<Real>(np);
+        std::copy(xp.dataPtr(), xp.dataPtr()+np, xp_save);
+        std::copy(yp.dataPtr(), yp.dataPtr()+np, yp_save);
+        std::copy(zp.dataPtr(), zp.dataPtr()+np, zp_save);
+        std::copy(uxp.dataPtr(), uxp.dataPtr()+np, uxp_save);
+        std::copy(uyp.dataPtr(), uyp.dataPtr()+np, uyp_save);
+        std::copy(uzp.dataPtr(), uzp.dataPtr()+np, uzp_save);
         // Scale the fields of particles about to cross the injection plane.
         // This only approximates what should be happening. The particles
         // should by advanced a fraction of a time step instead.
@@ -309,17 +322,8 @@ RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
 }
 
 void
-RigidInjectedParticleContainer::Evolve (int lev,
-                                        const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
-                                        const MultiFab& Bx, const MultiFab& By, const MultiFab& Bz,
-                                        MultiFab& jx, MultiFab& jy, MultiFab& jz,
-                                        MultiFab* cjx, MultiFab* cjy, MultiFab* cjz,
-                                        MultiFab* rho, MultiFab* crho,
-                                        const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
-                                        const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
-                                        Real t, Real dt)
+RigidInjectedParticleContainer::PreEvolve (int lev, Real dt)
 {
-
     // Update location of injection plane in the boosted frame
     zinject_plane_lev_previous = zinject_plane_levels[lev];
     zinject_plane_levels[lev] -= dt*WarpX::beta_boost*PhysConst::c;
@@ -333,16 +337,12 @@ RigidInjectedParticleContainer::Evolve (int lev,
 #endif
     done_injecting_temp.assign(nthreads, 1); // We do not use bool because vector<bool> is special.
     done_injecting_lev = done_injecting[lev];
+}
 
-    PhysicalParticleContainer::Evolve (lev,
-				       Ex, Ey, Ez,
-				       Bx, By, Bz,
-				       jx, jy, jz,
-                                       cjx, cjy, cjz,
-                                       rho, crho,
-                                       cEx, cEy, cEz,
-                                       cBx, cBy, cBz,
-                                       t, dt);
+void
+RigidInjectedParticleContainer::PostEvolve (int lev)
+{
+    PhysicalParticleContainer::PostEvolve(lev);
 
     // Check if all done_injecting_temp are still true.
     done_injecting[lev] = std::all_of(done_injecting_temp.begin(), done_injecting_temp.end(),
@@ -356,13 +356,19 @@ RigidInjectedParticleContainer::PushP (int lev, Real dt,
 {
     if (do_not_push) return;
 
-    const std::array<Real,3>& dx = WarpX::CellSize(lev);
-
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
     {
-        Cuda::ManagedDeviceVector<Real> xp, yp, zp, giv;
+#ifdef _OPENMP
+        int thread_num = omp_get_thread_num();
+#else
+        int thread_num = 0;
+#endif
+        auto& xp = m_xp[thread_num];
+        auto& yp = m_yp[thread_num];
+        auto& zp = m_zp[thread_num];
+        auto& giv = m_giv[thread_num];
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
@@ -373,12 +379,13 @@ RigidInjectedParticleContainer::PushP (int lev, Real dt,
             auto& uxp = attribs[PIdx::ux];
             auto& uyp = attribs[PIdx::uy];
             auto& uzp = attribs[PIdx::uz];
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+            auto gathered_fields = GetGatheredFields(pti);
+            auto& Exp = *gathered_fields[GatheredFieldIdx::Ex];
+            auto& Eyp = *gathered_fields[GatheredFieldIdx::Ey];
+            auto& Ezp = *gathered_fields[GatheredFieldIdx::Ez];
+            auto& Bxp = *gathered_fields[GatheredFieldIdx::Bx];
+            auto& Byp = *gathered_fields[GatheredFieldIdx::By];
+            auto& Bzp = *gathered_fields[GatheredFieldIdx::Bz];
 
             const long np = pti.numParticles();
 
@@ -404,36 +411,22 @@ RigidInjectedParticleContainer::PushP (int lev, Real dt,
             //
             pti.GetPosition(xp, yp, zp);
 
-            const std::array<Real,3>& xyzmin_grid = WarpX::LowerCorner(box, lev);
-            const int* ixyzmin_grid = box.loVect();
-
-            const int ll4symtry          = false;
             const int l_lower_order_in_v = true;
-            long lvect_fieldgathe = 64;
-            warpx_geteb_energy_conserving(
-                &np,
-                xp.dataPtr(),
-                yp.dataPtr(),
-                zp.dataPtr(),
-                Exp.dataPtr(),Eyp.dataPtr(),Ezp.dataPtr(),
-                Bxp.dataPtr(),Byp.dataPtr(),Bzp.dataPtr(),
-                ixyzmin_grid,
-                &xyzmin_grid[0], &xyzmin_grid[1], &xyzmin_grid[2],
-                &dx[0], &dx[1], &dx[2],
-                &WarpX::nox, &WarpX::noy, &WarpX::noz,
-                BL_TO_FORTRAN_ANYD(exfab),
-                BL_TO_FORTRAN_ANYD(eyfab),
-                BL_TO_FORTRAN_ANYD(ezfab),
-                BL_TO_FORTRAN_ANYD(bxfab),
-                BL_TO_FORTRAN_ANYD(byfab),
-                BL_TO_FORTRAN_ANYD(bzfab),
-                &ll4symtry, &l_lower_order_in_v, &WarpX::do_nodal,
-                &lvect_fieldgathe, &WarpX::field_gathering_algo);
-
-            // Save the position and momenta, making copies
-            auto uxp_save = uxp;
-            auto uyp_save = uyp;
-            auto uzp_save = uzp;
+            GatherFields(xp.dataPtr(), yp.dataPtr(), zp.dataPtr(),
+                         Exp.dataPtr(), Eyp.dataPtr(), Ezp.dataPtr(),
+                         Bxp.dataPtr(), Byp.dataPtr(), Bzp.dataPtr(), np,
+                         exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                         box, lev, l_lower_order_in_v);
+
+            // Save the momenta, making copies
+            ScratchArena& arena = ScratchArena::ThreadArena();
+            arena.reset();
+            Real* uxp_save = arena.alloc<Real>(np);
+            Real* uyp_save = arena.alloc<Real>(np);
+            Real* uzp_save = arena.alloc<Real>(np);
+            std::copy(uxp.dataPtr(), uxp.dataPtr()+np, uxp_save);
+            std::copy(uyp.dataPtr(), uyp.dataPtr()+np, uyp_save);
+            std::copy(uzp.dataPtr(), uzp.dataPtr()+np, uzp_save);
 
             warpx_particle_pusher_momenta(&np,
                                           xp.dataPtr(),
@@ -1,11 +1,16 @@
 
+#include <cmath>
 #include <limits>
+#include <numeric>
 
 #include <MultiParticleContainer.H>
 #include <WarpXParticleContainer.H>
 #include <AMReX_AmrParGDB.H>
 #include <WarpX_f.H>
 #include <WarpX.H>
+#include <CurrentDeposition.H>
+#include <FieldGather.H>
+#include <ScratchArena.H>
 
 using namespace amrex;
 
@@ -57,9 +62,11 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     : ParticleContainer<0,0,PIdx::nattribs>(amr_core->GetParGDB())
     , species_id(ispecies)
 {
+#ifndef WARPX_LEAN_PARTICLES
     for (unsigned int i = PIdx::Ex; i <= PIdx::Bz; ++i) {
         communicate_real_comp[i] = false; // Don't need to communicate E and B.
     }
+#endif
     SetParticleSize();
     ReadParameters();
 
@@ -68,12 +75,14 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     particle_comps["ux"] = PIdx::ux;
     particle_comps["uy"] = PIdx::uy;
     particle_comps["uz"] = PIdx::uz;
+#ifndef WARPX_LEAN_PARTICLES
     particle_comps["Ex"] = PIdx::Ex;
     particle_comps["Ey"] = PIdx::Ey;
     particle_comps["Ez"] = PIdx::Ez;
     particle_comps["Bx"] = PIdx::Bx;
     particle_comps["By"] = PIdx::By;
     particle_comps["Bz"] = PIdx::Bz;
+#endif
 #ifdef WARPX_RZ
     particle_comps["theta"] = PIdx::theta;
 #endif
@@ -104,6 +113,117 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     m_yp.resize(num_threads);
     m_zp.resize(num_threads);
     m_giv.resize(num_threads);
+    m_reorder_scratch.resize(num_threads);
+#ifdef WARPX_LEAN_PARTICLES
+    m_gathered_fields.resize(num_threads);
+#endif
+}
+
+std::array<WarpXParticleContainer::RealVector*, GatheredFieldIdx::nfields>
+WarpXParticleContainer::GetGatheredFields (WarpXParIter& pti)
+{
+    std::array<RealVector*, GatheredFieldIdx::nfields> fields;
+#ifdef WARPX_LEAN_PARTICLES
+#ifdef _OPENMP
+    const int thread_num = omp_get_thread_num();
+#else
+    const int thread_num = 0;
+#endif
+    const long np = pti.numParticles();
+    for (int i = 0; i < GatheredFieldIdx::nfields; ++i) {
+        m_gathered_fields[thread_num][i].resize(np);
+        fields[i] = &m_gathered_fields[thread_num][i];
+    }
+#else
+    auto& attribs = pti.GetAttribs();
+    fields[GatheredFieldIdx::Ex] = &attribs[PIdx::Ex];
+    fields[GatheredFieldIdx::Ey] = &attribs[PIdx::Ey];
+    fields[GatheredFieldIdx::Ez] = &attribs[PIdx::Ez];
+    fields[GatheredFieldIdx::Bx] = &attribs[PIdx::Bx];
+    fields[GatheredFieldIdx::By] = &attribs[PIdx::By];
+    fields[GatheredFieldIdx::Bz] = &attribs[PIdx::Bz];
+#endif
+    return fields;
+}
+
+void
+WarpXParticleContainer::GatherFields (const Real* xp, const Real* yp, const Real* zp,
+                                      Real* Exp, Real* Eyp, Real* Ezp,
+                                      Real* Bxp, Real* Byp, Real* Bzp, long np,
+                                      const FArrayBox& exfab, const FArrayBox& eyfab,
+                                      const FArrayBox& ezfab, const FArrayBox& bxfab,
+                                      const FArrayBox& byfab, const FArrayBox& bzfab,
+                                      const Box& box, int lev, int lower_order_in_v) const
+{
+    if (np <= 0) return;
+
+    const std::array<Real,3>& dx = WarpX::CellSize(lev);
+    const std::array<Real,3>& xyzmin = WarpX::LowerCorner(box, lev);
+
+    // The C++ kernels use the same shape order in all directions. In RZ,
+    // PICSAR gathers at the Cartesian positions of the particles.
+#if defined(AMREX_USE_GPU) || defined(WARPX_RZ)
+    const bool use_cpp_gather = false;
+#else
+    const bool use_cpp_gather = !WarpX::use_picsar_gather &&
+        WarpX::nox >= 1 && WarpX::nox <= 3 &&
+        AMREX_D_TERM(true, && WarpX::noy == WarpX::nox, && WarpX::noz == WarpX::nox);
+#endif
+
+    if (use_cpp_gather)
+    {
+        const Dim3 lo = amrex::lbound(box);
+        const auto ex_arr = exfab.array();
+        const auto ey_arr = eyfab.array();
+        const auto ez_arr = ezfab.array();
+        const auto bx_arr = bxfab.array();
+        const auto by_arr = byfab.array();
+        const auto bz_arr = bzfab.array();
+        const bool lower_in_v = lower_order_in_v && !WarpX::do_nodal;
+
+#define WARPX_GATHER_KERNEL(ORDER)                                      \
+        if (WarpX::do_nodal) {                                          \
+            doGatherShapeN<ORDER,0,1>(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp, np, \
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr, dx, xyzmin, lo); \
+        } else if (lower_in_v) {                                        \
+            doGatherShapeN<ORDER,1,0>(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp, np, \
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr, dx, xyzmin, lo); \
+        } else {                                                        \
+            doGatherShapeN<ORDER,0,0>(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp, np, \
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr, dx, xyzmin, lo); \
+        }
+
+        if        (WarpX::nox == 1) {
+            WARPX_GATHER_KERNEL(1);
+        } else if (WarpX::nox == 2) {
+            WARPX_GATHER_KERNEL(2);
+        } else if (WarpX::nox == 3) {
+            WARPX_GATHER_KERNEL(3);
+        }
+
+#undef WARPX_GATHER_KERNEL
+    }
+    else
+    {
+        const int* ixyzmin = box.loVect();
+        const int ll4symtry = false;
+        long lvect_fieldgathe = 64;
+        warpx_geteb_energy_conserving(
+            &np, xp, yp, zp,
+            Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+            ixyzmin,
+            &xyzmin[0], &xyzmin[1], &xyzmin[2],
+            &dx[0], &dx[1], &dx[2],
+            &WarpX::nox, &WarpX::noy, &WarpX::noz,
+            BL_TO_FORTRAN_ANYD(exfab),
+            BL_TO_FORTRAN_ANYD(eyfab),
+            BL_TO_FORTRAN_ANYD(ezfab),
+            BL_TO_FORTRAN_ANYD(bxfab),
+            BL_TO_FORTRAN_ANYD(byfab),
+            BL_TO_FORTRAN_ANYD(bzfab),
+            &ll4symtry, &lower_order_in_v, &WarpX::do_nodal,
+            &lvect_fieldgathe, &WarpX::field_gathering_algo);
+    }
 }
 
 void
@@ -167,6 +287,15 @@ WarpXParticleContainer::AddOneParticle (ParticleTileType& particle_tile,
 
     particle_tile.push_back(p);
     particle_tile.push_back_real(attribs);
+
+#ifdef WARPX_LEAN_PARTICLES
+    if (WarpX::plot_particle_fields)
+    {
+        for (const auto& name : ParticleStringNames::field_names) {
+            particle_tile.push_back_real(particle_comps[name], 0.0);
+        }
+    }
+#endif
 }
 
 void
@@ -270,12 +399,126 @@ WarpXParticleContainer::AddNParticles (int lev,
             particle_tile.push_back_real(comp, np, 0.0);
 #endif
         }
+
+#ifdef WARPX_LEAN_PARTICLES
+        if (WarpX::plot_particle_fields)
+        {
+            for (const auto& name : ParticleStringNames::field_names) {
+                particle_tile.push_back_real(particle_comps[name], np, 0.0);
+            }
+        }
+#endif
     }
 
     Redistribute();
 }
 
 
+namespace
+{
+    // Box of the cells that can receive current from the particles
+    // [0, np) of a tile, given their positions and the lower corner
+    // `xyzmin` of `tile_box`. Only this region of the thread-local
+    // current arrays needs to be zeroed and added to the grid.
+    Box depositionBox (const Box& tile_box, const std::array<Real,3>& xyzmin,
+                       const std::array<Real,3>& dx,
+                       const Real* xp, const Real* yp, const Real* zp, const long np)
+    {
+        const Real dxi = 1./dx[0];
+        const Real dzi = 1./dx[2];
+        Real xmin = std::numeric_limits<Real>::max();
+        Real xmax = std::numeric_limits<Real>::lowest();
+        Real zmin = xmin;
+        Real zmax = xmax;
+#if (AMREX_SPACEDIM == 3)
+        const Real dyi = 1./dx[1];
+        Real ymin = xmin;
+        Real ymax = xmax;
+#endif
+        for (long ip = 0; ip < np; ++ip) {
+            xmin = std::min(xmin, xp[ip]);
+            xmax = std::max(xmax, xp[ip]);
+#if (AMREX_SPACEDIM == 3)
+            ymin = std::min(ymin, yp[ip]);
+            ymax = std::max(ymax, yp[ip]);
+#endif
+            zmin = std::min(zmin, zp[ip]);
+            zmax = std::max(zmax, zp[ip]);
+        }
+
+        const IntVect& lo = tile_box.smallEnd();
+#if (AMREX_SPACEDIM == 3)
+        const IntVect dlo(lo[0] + static_cast<int>(std::floor((xmin-xyzmin[0])*dxi)),
+                          lo[1] + static_cast<int>(std::floor((ymin-xyzmin[1])*dyi)),
+                          lo[2] + static_cast<int>(std::floor((zmin-xyzmin[2])*dzi)));
+        const IntVect dhi(lo[0] + static_cast<int>(std::floor((xmax-xyzmin[0])*dxi)),
+                          lo[1] + static_cast<int>(std::floor((ymax-xyzmin[1])*dyi)),
+                          lo[2] + static_cast<int>(std::floor((zmax-xyzmin[2])*dzi)));
+        // The shape factors extend over `order` cells around the particle;
+        // the extra cells account for the staggering of the current and for
+        // the motion of the particles during the step (Esirkepov).
+        const IntVect nstencil(WarpX::nox+2, WarpX::noy+2, WarpX::noz+2);
+#else
+        const IntVect dlo(lo[0] + static_cast<int>(std::floor((xmin-xyzmin[0])*dxi)),
+                          lo[1] + static_cast<int>(std::floor((zmin-xyzmin[2])*dzi)));
+        const IntVect dhi(lo[0] + static_cast<int>(std::floor((xmax-xyzmin[0])*dxi)),
+                          lo[1] + static_cast<int>(std::floor((zmax-xyzmin[2])*dzi)));
+        const IntVect nstencil(WarpX::nox+2, WarpX::noz+2);
+#endif
+        return amrex::grow(Box(dlo, dhi), nstencil);
+    }
+
+    // Current deposition of np particles on the thread-local arrays
+    // jxfab, jyfab, jzfab with the C++ kernels of CurrentDeposition.H,
+    // dispatched on the shape order.
+    void depositCurrentCpp (const Real* xp, const Real* yp, const Real* zp,
+                            const Real* wp, const Real* uxp, const Real* uyp, const Real* uzp,
+                            const Real* gaminv, const long np, const Real q,
+                            FArrayBox& jxfab, FArrayBox& jyfab, FArrayBox& jzfab,
+                            const bool j_is_nodal, const Real dt,
+                            const std::array<Real,3>& dx, const std::array<Real,3>& xyzmin,
+                            const Box& tile_box)
+    {
+        const bool esirkepov = (WarpX::current_deposition_algo < 2) && !j_is_nodal;
+        const Dim3 lo = amrex::lbound(tile_box);
+        const auto jx_arr = jxfab.array();
+        const auto jy_arr = jyfab.array();
+        const auto jz_arr = jzfab.array();
+        if        (WarpX::nox == 1) {
+            doDepositionShapeN<1>(xp, yp, zp, wp, uxp, uyp, uzp, gaminv, np, q,
+                                  jx_arr, jy_arr, jz_arr, esirkepov, j_is_nodal,
+                                  dt, dx, xyzmin, lo);
+        } else if (WarpX::nox == 2) {
+            doDepositionShapeN<2>(xp, yp, zp, wp, uxp, uyp, uzp, gaminv, np, q,
+                                  jx_arr, jy_arr, jz_arr, esirkepov, j_is_nodal,
+                                  dt, dx, xyzmin, lo);
+        } else if (WarpX::nox == 3) {
+            doDepositionShapeN<3>(xp, yp, zp, wp, uxp, uyp, uzp, gaminv, np, q,
+                                  jx_arr, jy_arr, jz_arr, esirkepov, j_is_nodal,
+                                  dt, dx, xyzmin, lo);
+        }
+    }
+
+    // Add `src` to `dst` over `bx`. Cells of `owned` can only be updated by
+    // the thread that works on the current tile, so they are added without
+    // atomics; the other cells may overlap with the guard cells of
+    // neighboring tiles of the same grid, and use atomic additions.
+    void addLocalCurrent (FArrayBox& dst, const FArrayBox& src, const Box& bx, const Box& owned)
+    {
+        if (!bx.ok()) return;
+        const Box& interior = bx & owned;
+        if (interior.ok()) {
+            dst.plus(src, interior, interior, 0, 0, 1);
+            const BoxList& shell = amrex::boxDiff(bx, interior);
+            for (const Box& b : shell) {
+                dst.atomicAdd(src, b, b, 0, 0, 1);
+            }
+        } else {
+            dst.atomicAdd(src, bx, bx, 0, 0, 1);
+        }
+    }
+}
+
 void
 WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
                                        RealVector& wp, RealVector& uxp,
@@ -286,7 +529,9 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
                                        int thread_num, int lev, Real dt )
 {
   Real *jx_ptr, *jy_ptr, *jz_ptr;
-  const std::array<Real,3>& xyzmin_tile = WarpX::LowerCorner(pti.tilebox(), lev);
+  // The current is defined at t+dt/2: take into account the motion
+  // of the grid with the Galilean solver
+  const std::array<Real,3>& xyzmin_tile = WarpX::LowerCorner(pti.tilebox(), lev, 0.5*dt);
   const std::array<Real,3>& dx = WarpX::CellSize(lev);
   const std::array<Real,3>& cdx = WarpX::CellSize(std::max(lev-1,0));
   const std::array<Real, 3>& xyzmin = xyzmin_tile;
@@ -304,6 +549,16 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
 
   bool j_is_nodal = jx.is_nodal() and jy.is_nodal() and jz.is_nodal();
 
+  // The C++ kernels use the same shape order in all directions, and
+  // deposit on thread-local arrays (i.e. not on GPU)
+#if defined(AMREX_USE_GPU) || defined(WARPX_RZ)
+  const bool use_cpp_deposition = false;
+#else
+  const bool use_cpp_deposition = !WarpX::use_picsar_deposition &&
+      WarpX::nox >= 1 && WarpX::nox <= 3 &&
+      AMREX_D_TERM(true, && WarpX::noy == WarpX::nox, && WarpX::noz == WarpX::nox);
+#endif
+
   // Deposit charge for particles that are not in the current buffers
   if (np_current > 0)
   {
@@ -316,6 +571,11 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
       auto jyntot = jy[pti].length();
       auto jzntot = jz[pti].length();
 #else
+      // Cells that belong to this tile only
+      const Box& owned_x = amrex::grow(tbx, -(ngJ+1));
+      const Box& owned_y = amrex::grow(tby, -(ngJ+1));
+      const Box& owned_z = amrex::grow(tbz, -(ngJ+1));
+
       tbx.grow(ngJ);
       tby.grow(ngJ);
       tbz.grow(ngJ);
@@ -327,10 +587,25 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
       jx_ptr = local_jx[thread_num].dataPtr();
       jy_ptr = local_jy[thread_num].dataPtr();
       jz_ptr = local_jz[thread_num].dataPtr();
-      
-      local_jx[thread_num].setVal(0.0);
-      local_jy[thread_num].setVal(0.0);
-      local_jz[thread_num].setVal(0.0);
+
+      // Only zero (and later add back) the region touched by the particles
+#ifdef WARPX_RZ
+      // The RZ volume scaling is applied to the whole local array,
+      // including the guard cells where the particles deposit
+      const Box& depos_box = amrex::grow(pti.tilebox(), ngJ);
+#else
+      const Box& depos_box = depositionBox(pti.tilebox(), xyzmin, dx,
+                                           m_xp[thread_num].dataPtr(),
+                                           m_yp[thread_num].dataPtr(),
+                                           m_zp[thread_num].dataPtr(), np_current);
+#endif
+      const Box& dbx = amrex::convert(depos_box, WarpX::jx_nodal_flag) & tbx;
+      const Box& dby = amrex::convert(depos_box, WarpX::jy_nodal_flag) & tby;
+      const Box& dbz = amrex::convert(depos_box, WarpX::jz_nodal_flag) & tbz;
+
+      local_jx[thread_num].setVal(0.0, dbx, 0, 1);
+      local_jy[thread_num].setVal(0.0, dby, 0, 1);
+      local_jz[thread_num].setVal(0.0, dbz, 0, 1);
 
       auto jxntot = local_jx[thread_num].length();
       auto jyntot = local_jy[thread_num].length();
@@ -338,14 +613,26 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
 #endif
 
       BL_PROFILE_VAR_START(blp_pxr_cd);
-      if (j_is_nodal) {
+      if (use_cpp_deposition) {
+          depositCurrentCpp(m_xp[thread_num].dataPtr(),
+                            m_yp[thread_num].dataPtr(),
+                            m_zp[thread_num].dataPtr(),
+                            wp.dataPtr(), uxp.dataPtr(), uyp.dataPtr(), uzp.dataPtr(),
+                            m_giv[thread_num].dataPtr(), np_current, this->charge,
+                            local_jx[thread_num], local_jy[thread_num], local_jz[thread_num],
+                            j_is_nodal, dt, dx, xyzmin, pti.tilebox());
+      } else if (j_is_nodal) {
           const Real* p_wp = wp.dataPtr();
           const Real* p_gaminv = m_giv[thread_num].dataPtr();
           const Real* p_uxp = uxp.dataPtr();
           const Real* p_uyp = uyp.dataPtr();
           const Real* p_uzp = uzp.dataPtr();
+#ifdef AMREX_USE_GPU
           AsyncArray<Real> wptmp_aa(np_current);
           Real* const wptmp = wptmp_aa.data();
+#else
+          Real* const wptmp = ScratchArena::ThreadArena().alloc<Real>(np_current);
+#endif
           const Box& tile_box = pti.tilebox();
 #if (AMREX_SPACEDIM == 3)
           const long nx = tile_box.length(0);
@@ -429,9 +716,9 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
 #ifndef AMREX_USE_GPU            
       BL_PROFILE_VAR_START(blp_accumulate);
 
-      jx[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, 1);
-      jy[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, 1);
-      jz[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, 1);
+      addLocalCurrent(jx[pti], local_jx[thread_num], dbx, owned_x);
+      addLocalCurrent(jy[pti], local_jy[thread_num], dby, owned_y);
+      addLocalCurrent(jz[pti], local_jz[thread_num], dbz, owned_z);
 
       BL_PROFILE_VAR_STOP(blp_accumulate);
 #endif
@@ -442,7 +729,7 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
   {
       const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
       const Box& ctilebox = amrex::coarsen(pti.tilebox(),ref_ratio);
-      const std::array<Real,3>& cxyzmin_tile = WarpX::LowerCorner(ctilebox, lev-1);
+      const std::array<Real,3>& cxyzmin_tile = WarpX::LowerCorner(ctilebox, lev-1, 0.5*dt);
 
 #ifdef AMREX_USE_GPU
       jx_ptr = (*cjx)[pti].dataPtr();
@@ -457,6 +744,13 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
       tbx = amrex::convert(ctilebox, WarpX::jx_nodal_flag);
       tby = amrex::convert(ctilebox, WarpX::jy_nodal_flag);
       tbz = amrex::convert(ctilebox, WarpX::jz_nodal_flag);
+
+      // Cells that belong to this tile only (the coarsened tiles of a grid
+      // may share one cell when the tile size is not a multiple of the ratio)
+      const Box& owned_x = amrex::grow(tbx, -(ngJ+2));
+      const Box& owned_y = amrex::grow(tby, -(ngJ+2));
+      const Box& owned_z = amrex::grow(tbz, -(ngJ+2));
+
       tbx.grow(ngJ);
       tby.grow(ngJ);
       tbz.grow(ngJ);
@@ -469,9 +763,24 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
       jy_ptr = local_jy[thread_num].dataPtr();
       jz_ptr = local_jz[thread_num].dataPtr();
 
-      local_jx[thread_num].setVal(0.0);
-      local_jy[thread_num].setVal(0.0);
-      local_jz[thread_num].setVal(0.0);
+      // Only zero (and later add back) the region touched by the particles
+#ifdef WARPX_RZ
+      // As above, the whole local array (including its guard cells)
+      const Box& depos_box = amrex::grow(ctilebox, ngJ);
+#else
+      const Box& depos_box = depositionBox(ctilebox, cxyzmin_tile, cdx,
+                                           m_xp[thread_num].dataPtr() + np_current,
+                                           m_yp[thread_num].dataPtr() + np_current,
+                                           m_zp[thread_num].dataPtr() + np_current,
+                                           np - np_current);
+#endif
+      const Box& dbx = amrex::convert(depos_box, WarpX::jx_nodal_flag) & tbx;
+      const Box& dby = amrex::convert(depos_box, WarpX::jy_nodal_flag) & tby;
+      const Box& dbz = amrex::convert(depos_box, WarpX::jz_nodal_flag) & tbz;
+
+      local_jx[thread_num].setVal(0.0, dbx, 0, 1);
+      local_jy[thread_num].setVal(0.0, dby, 0, 1);
+      local_jz[thread_num].setVal(0.0, dbz, 0, 1);
 
       auto jxntot = local_jx[thread_num].length();
       auto jyntot = local_jy[thread_num].length();
@@ -480,14 +789,27 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
       
       long ncrse = np - np_current;
       BL_PROFILE_VAR_START(blp_pxr_cd);
-      if (j_is_nodal) {
+      if (use_cpp_deposition) {
+          depositCurrentCpp(m_xp[thread_num].dataPtr() + np_current,
+                            m_yp[thread_num].dataPtr() + np_current,
+                            m_zp[thread_num].dataPtr() + np_current,
+                            wp.dataPtr() + np_current, uxp.dataPtr() + np_current,
+                            uyp.dataPtr() + np_current, uzp.dataPtr() + np_current,
+                            m_giv[thread_num].dataPtr() + np_current, ncrse, this->charge,
+                            local_jx[thread_num], local_jy[thread_num], local_jz[thread_num],
+                            j_is_nodal, dt, cdx, cxyzmin_tile, ctilebox);
+      } else if (j_is_nodal) {
           const Real* p_wp = wp.dataPtr() + np_current;
           const Real* p_gaminv = m_giv[thread_num].dataPtr() + np_current;
           const Real* p_uxp = uxp.dataPtr() + np_current;
           const Real* p_uyp = uyp.dataPtr() + np_current;
           const Real* p_uzp = uzp.dataPtr() + np_current;
+#ifdef AMREX_USE_GPU
           AsyncArray<Real> wptmp_aa(ncrse);
           Real* const wptmp = wptmp_aa.data();
+#else
+          Real* const wptmp = ScratchArena::ThreadArena().alloc<Real>(ncrse);
+#endif
           const Box& tile_box = pti.tilebox();
 #if (AMREX_SPACEDIM == 3)
           const long nx = tile_box.length(0);
@@ -572,9 +894,9 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
 #ifndef AMREX_USE_GPU
       BL_PROFILE_VAR_START(blp_accumulate);
 
-      (*cjx)[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, 1);
-      (*cjy)[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, 1);
-      (*cjz)[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, 1);
+      addLocalCurrent((*cjx)[pti], local_jx[thread_num], dbx, owned_x);
+      addLocalCurrent((*cjy)[pti], local_jy[thread_num], dby, owned_y);
+      addLocalCurrent((*cjz)[pti], local_jz[thread_num], dbz, owned_z);
 
       BL_PROFILE_VAR_STOP(blp_accumulate);
 #endif
@@ -592,7 +914,10 @@ WarpXParticleContainer::DepositCharge ( WarpXParIter& pti, RealVector& wp,
   BL_PROFILE_VAR_NS("PICSAR::ChargeDeposition", blp_pxr_chd);
   BL_PROFILE_VAR_NS("PPC::Evolve::Accumulate", blp_accumulate);
 
-  const std::array<Real,3>& xyzmin_tile = WarpX::LowerCorner(pti.tilebox(), lev);
+  // rho_new (icomp=1) is defined at t+dt: take into account the motion
+  // of the grid with the Galilean solver
+  const Real time_shift = (icomp == 1) ? WarpX::GetInstance().getdt(lev) : 0.;
+  const std::array<Real,3>& xyzmin_tile = WarpX::LowerCorner(pti.tilebox(), lev, time_shift);
   const long lvect = 8;
 
   long ngRho = rhomf->nGrow();
@@ -657,7 +982,7 @@ WarpXParticleContainer::DepositCharge ( WarpXParIter& pti, RealVector& wp,
   {
       const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
       const Box& ctilebox = amrex::coarsen(pti.tilebox(), ref_ratio);
-      const std::array<Real,3>& cxyzmin_tile = WarpX::LowerCorner(ctilebox, lev-1);
+      const std::array<Real,3>& cxyzmin_tile = WarpX::LowerCorner(ctilebox, lev-1, time_shift);
 
 #ifdef AMREX_USE_GPU
       data_ptr = (*crhomf)[pti].dataPtr();
@@ -1018,7 +1343,16 @@ WarpXParticleContainer::PushX (int lev, Real dt)
 #pragma omp parallel
 #endif
     {
-        Cuda::ManagedDeviceVector<Real> xp, yp, zp, giv;
+#ifdef _OPENMP
+        int thread_num = omp_get_thread_num();
+#else
+        int thread_num = 0;
+#endif
+        // Per-thread arrays, which keep their capacity from one call to the next
+        auto& xp = m_xp[thread_num];
+        auto& yp = m_yp[thread_num];
+        auto& zp = m_zp[thread_num];
+        auto& giv = m_giv[thread_num];
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
@@ -1073,6 +1407,128 @@ WarpXParticleContainer::PushX (int lev, Real dt)
     }
 }
 
+namespace
+{
+    // Reorder `v` according to `perm`, using `tmp` as scratch space.
+    // After the swap, `tmp` holds the old buffer of `v`, whose capacity
+    // is reused the next time.
+    template <typename VectorType>
+    void permuteVector (VectorType& v, VectorType& tmp, const Vector<long>& perm)
+    {
+        const long np = perm.size();
+        tmp.resize(np);
+        for (long ip = 0; ip < np; ++ip) {
+            tmp[ip] = v[perm[ip]];
+        }
+        std::swap(v, tmp);
+    }
+}
+
+void
+WarpXParticleContainer::ReorderParticles (WarpXParIter& pti, const Vector<long>& perm,
+                                          ReorderScratch& scratch)
+{
+    BL_ASSERT(perm.size() == pti.numParticles());
+
+    permuteVector(pti.GetArrayOfStructs()(), scratch.particle_tmp, perm);
+    auto& soa = pti.GetStructOfArrays();
+    for (int comp = 0; comp < NumRealComps(); ++comp) {
+        permuteVector(soa.GetRealData(comp), scratch.real_tmp, perm);
+    }
+    for (int comp = 0; comp < NumIntComps(); ++comp) {
+        permuteVector(soa.GetIntData(comp), scratch.int_tmp, perm);
+    }
+}
+
+void
+WarpXParticleContainer::SortParticlesInTiles ()
+{
+    for (int lev = 0; lev <= finestLevel(); ++lev) {
+        SortParticlesInTiles(lev);
+    }
+}
+
+WarpXParticleContainer::BufferBuckets::BufferBuckets (const iMultiFab* gather_masks,
+                                                     const iMultiFab* current_masks)
+{
+    const bool gather_is_larger = (WarpX::n_field_gather_buffer >= WarpX::n_current_deposition_buffer);
+    large_masks = (gather_is_larger) ? gather_masks : current_masks;
+    small_masks = (gather_is_larger) ? current_masks : gather_masks;
+    const int n_small_buf = (gather_is_larger) ? WarpX::n_current_deposition_buffer
+                                               : WarpX::n_field_gather_buffer;
+    use_small_masks = (n_small_buf > 0) && (small_masks != nullptr) &&
+        (WarpX::n_field_gather_buffer != WarpX::n_current_deposition_buffer);
+}
+
+void
+WarpXParticleContainer::SortParticlesInTiles (int lev)
+{
+    BL_PROFILE("WPC::SortParticlesInTiles()");
+
+    const BufferBuckets buckets(WarpX::GatherBufferMasks(lev),
+                                WarpX::CurrentBufferMasks(lev));
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+        int thread_num = omp_get_thread_num();
+#else
+        int thread_num = 0;
+#endif
+        auto& scratch = m_reorder_scratch[thread_num];
+        auto& cells = scratch.keys;
+        auto& offsets = scratch.offsets;
+        auto& perm = scratch.perm;
+
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            const long np = pti.numParticles();
+            if (np < 2) continue;
+
+            auto& aos = pti.GetArrayOfStructs();
+            const Box& box = pti.tilebox();
+            const long ncells = box.numPts();
+
+            // Index of the cell of each particle within the tile. Particles
+            // that are slightly outside of the tile (e.g. after a local
+            // redistribute) are binned with the closest cell of the tile.
+            // On levels with mesh refinement buffers, the particles are first
+            // grouped by buffer bucket, in the order of
+            // PartitionParticlesInBuffers, so that the partition does not
+            // undo the sort at the next push.
+            cells.resize(np);
+            bool is_sorted = true;
+            for (long ip = 0; ip < np; ++ip) {
+                IntVect iv = Index(aos[ip], lev);
+                iv.max(box.smallEnd());
+                iv.min(box.bigEnd());
+                cells[ip] = box.index(iv);
+                if (buckets.ok()) cells[ip] += buckets(pti, iv)*ncells;
+                if (ip > 0 && cells[ip] < cells[ip-1]) is_sorted = false;
+            }
+
+            // Most particles stay in the same cell from one step to the next,
+            // so the tile is often still sorted.
+            if (is_sorted) continue;
+
+            // Stable counting sort by cell index
+            offsets.assign(((buckets.ok()) ? 3 : 1)*ncells+1, 0);
+            for (long ip = 0; ip < np; ++ip) {
+                ++offsets[cells[ip]+1];
+            }
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            perm.resize(np);
+            for (long ip = 0; ip < np; ++ip) {
+                perm[offsets[cells[ip]]++] = ip;
+            }
+
+            ReorderParticles(pti, perm, scratch);
+        }
+    }
+}
+
 // This function is called in Redistribute, just after locate
 void 
 WarpXParticleContainer::particlePostLocate(ParticleType& p, 
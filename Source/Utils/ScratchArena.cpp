@@ -0,0 +1,145 @@
+#include <algorithm>
+
+#include <AMReX_Arena.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_BLProfiler.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <ScratchArena.H>
+
+using namespace amrex;
+
+Vector<ScratchArena> ScratchArena::m_thread_arenas;
+
+namespace
+{
+    // Alignment of all the allocations, large enough for SIMD loads
+    constexpr std::size_t arena_alignment = 64;
+
+    std::size_t alignUp (std::size_t nbytes)
+    {
+        return (nbytes + arena_alignment - 1) / arena_alignment * arena_alignment;
+    }
+}
+
+ScratchArena::~ScratchArena ()
+{
+    release();
+}
+
+ScratchArena::ScratchArena (ScratchArena&& rhs) noexcept
+    : m_blocks(std::move(rhs.m_blocks)),
+      m_offset(rhs.m_offset),
+      m_used(rhs.m_used),
+      m_num_allocations(rhs.m_num_allocations)
+{
+    rhs.m_blocks.clear();
+    rhs.m_offset = 0;
+    rhs.m_used = 0;
+}
+
+void*
+ScratchArena::allocBytes (std::size_t nbytes)
+{
+    nbytes = alignUp(std::max(nbytes, std::size_t(1)));
+    if (m_blocks.empty() || m_offset + nbytes > m_blocks.back().second) {
+        grow(nbytes);
+    }
+    char* p = m_blocks.back().first + m_offset;
+    m_offset += nbytes;
+    m_used += nbytes;
+    return p;
+}
+
+void
+ScratchArena::grow (std::size_t nbytes)
+{
+    BL_PROFILE("ScratchArena::grow()");
+    // Grow geometrically, so that the number of blocks stays small
+    std::size_t block_size = std::max(nbytes, std::size_t(1024*1024));
+    if (!m_blocks.empty()) {
+        block_size = std::max(block_size, 2*m_blocks.back().second);
+    }
+    char* p = static_cast<char*>(The_Arena()->alloc(block_size));
+    m_blocks.push_back(std::make_pair(p, block_size));
+    m_offset = 0;
+    ++m_num_allocations;
+}
+
+void
+ScratchArena::reset ()
+{
+    if (m_blocks.size() > 1) {
+        // Merge the blocks into one that can hold everything that was
+        // allocated since the last reset
+        std::size_t total = 0;
+        for (const auto& b : m_blocks) total += b.second;
+        release();
+        grow(std::max(total, m_used));
+    }
+    m_offset = 0;
+    m_used = 0;
+}
+
+void
+ScratchArena::release ()
+{
+    for (const auto& b : m_blocks) {
+        The_Arena()->free(b.first);
+    }
+    m_blocks.clear();
+    m_offset = 0;
+}
+
+void
+ScratchArena::Initialize ()
+{
+#ifdef _OPENMP
+    BL_ASSERT(!omp_in_parallel());
+    const int nthreads = omp_get_max_threads();
+#else
+    const int nthreads = 1;
+#endif
+    if (static_cast<int>(m_thread_arenas.size()) < nthreads) {
+        m_thread_arenas.resize(nthreads);
+    }
+}
+
+void
+ScratchArena::Finalize ()
+{
+    m_thread_arenas.clear();
+}
+
+ScratchArena&
+ScratchArena::ThreadArena ()
+{
+#ifdef _OPENMP
+    const int thread_num = omp_get_thread_num();
+#else
+    const int thread_num = 0;
+#endif
+    BL_ASSERT(thread_num < static_cast<int>(m_thread_arenas.size()));
+    return m_thread_arenas[thread_num];
+}
+
+long
+ScratchArena::NumAllocations ()
+{
+    long n = 0;
+    for (const auto& a : m_thread_arenas) n += a.m_num_allocations;
+    return n;
+}
+
+long
+ScratchArena::NumBytes ()
+{
+    long n = 0;
+    for (const auto& a : m_thread_arenas) {
+        for (const auto& b : a.m_blocks) n += b.second;
+    }
+    return n;
+}
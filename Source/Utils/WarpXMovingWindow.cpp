@@ -1,4 +1,7 @@
 
+#include <cstdlib>
+#include <cstring>
+
 #include <WarpX.H>
 #include <WarpXConst.H>
 
@@ -24,6 +27,35 @@ WarpX::UpdatePlasmaInjectionPosition (Real dt)
     }
 }
 
+/* \brief With the Galilean PSATD solver, the grid moves continuously with
+ * the velocity `v_galilean`: shift the physical domain accordingly, at the
+ * end of a step of duration `dt`. (The fields are not shifted: they are
+ * already defined on the moving grid.) */
+void
+WarpX::ShiftGalileanGrid (Real dt)
+{
+    if (v_galilean[0] == 0. && v_galilean[1] == 0. && v_galilean[2] == 0.) return;
+
+    Real new_lo[AMREX_SPACEDIM];
+    Real new_hi[AMREX_SPACEDIM];
+    const Real* current_lo = geom[0].ProbLo();
+    const Real* current_hi = geom[0].ProbHi();
+    for (int i=0; i<AMREX_SPACEDIM; i++) {
+#if ( AMREX_SPACEDIM == 3 )
+        const Real v = v_galilean[i];
+#elif ( AMREX_SPACEDIM == 2 )
+        // In 2D, i=0 corresponds to x and i=1 corresponds to z
+        const Real v = v_galilean[2*i];
+#endif
+        new_lo[i] = current_lo[i] + v*dt;
+        new_hi[i] = current_hi[i] + v*dt;
+    }
+    // As in MoveWindow, the amrex::Geometry objects of all levels
+    // share the same, static RealBox
+    RealBox new_box(new_lo, new_hi);
+    Geometry::ProbDomain(new_box);
+}
+
 int
 WarpX::MoveWindow (bool move_j)
 {
@@ -41,94 +73,102 @@ WarpX::MoveWindow (bool move_j)
     const Real* current_lo = geom[0].ProbLo();
     const Real* current_hi = geom[0].ProbHi();
     const Real* cdx = geom[0].CellSize();
+    // With the Galilean PSATD solver, the domain has already moved with the
+    // grid during this step (see ShiftGalileanGrid): the window is only
+    // shifted by the number of cells by which it differs from the window
+    // position. The plasma may still have to be injected, in the cells
+    // that the drift of the grid brought into the domain.
     int num_shift_base = static_cast<int>((moving_window_x - current_lo[dir]) / cdx[dir]);
+#if ( AMREX_SPACEDIM == 3 )
+    const bool grid_drifts = (v_galilean[dir] != 0.);
+#elif ( AMREX_SPACEDIM == 2 )
+    const bool grid_drifts = (v_galilean[2*dir] != 0.);
+#endif
 
-    if (num_shift_base == 0) return 0;
+    if (num_shift_base == 0 && !grid_drifts) return 0;
 
-    // update the problem domain. Note the we only do this on the base level because
-    // amrex::Geometry objects share the same, static RealBox.
-    for (int i=0; i<AMREX_SPACEDIM; i++) {
-        new_lo[i] = current_lo[i];
-        new_hi[i] = current_hi[i];
-    }
-    new_lo[dir] = current_lo[dir] + num_shift_base * cdx[dir];
-    new_hi[dir] = current_hi[dir] + num_shift_base * cdx[dir];
-    RealBox new_box(new_lo, new_hi);
-    Geometry::ProbDomain(new_box);
-
-    int num_shift      = num_shift_base;
-    int num_shift_crse = num_shift;
+    if (num_shift_base != 0) {
+        // update the problem domain. Note the we only do this on the base level because
+        // amrex::Geometry objects share the same, static RealBox.
+        for (int i=0; i<AMREX_SPACEDIM; i++) {
+            new_lo[i] = current_lo[i];
+            new_hi[i] = current_hi[i];
+        }
+        new_lo[dir] = current_lo[dir] + num_shift_base * cdx[dir];
+        new_hi[dir] = current_hi[dir] + num_shift_base * cdx[dir];
+        RealBox new_box(new_lo, new_hi);
+        Geometry::ProbDomain(new_box);
 
-    // Shift the mesh fields
-    for (int lev = 0; lev <= finest_level; ++lev) {
+        int num_shift      = num_shift_base;
+        int num_shift_crse = num_shift;
 
-        if (lev > 0) {
-            num_shift_crse = num_shift;
-            num_shift *= refRatio(lev-1)[dir];
-        }
+        MarkFieldsModified();
 
-        // Shift each component of vector fields (E, B, j)
-        for (int dim = 0; dim < 3; ++dim) {
+        // Shift the mesh fields: on each level, all the fields of the fine patch
+        // (resp. coarse patch) are shifted together, with a single exchange of
+        // guard cells
+        for (int lev = 0; lev <= finest_level; ++lev) {
 
-            // Fine grid
-            shiftMF(*Bfield_fp[lev][dim], geom[lev], num_shift, dir);
-            shiftMF(*Efield_fp[lev][dim], geom[lev], num_shift, dir);
-            if (move_j) {
-                shiftMF(*current_fp[lev][dim], geom[lev], num_shift, dir);
-            }
-            if (do_pml && pml[lev]->ok()) {
-                const std::array<MultiFab*, 3>& pml_B = pml[lev]->GetB_fp();
-                const std::array<MultiFab*, 3>& pml_E = pml[lev]->GetE_fp();
-                shiftMF(*pml_B[dim], geom[lev], num_shift, dir);
-                shiftMF(*pml_E[dim], geom[lev], num_shift, dir);
+            if (lev > 0) {
+                num_shift_crse = num_shift;
+                num_shift *= refRatio(lev-1)[dir];
             }
 
-            if (lev > 0) {
-                // Coarse grid
-                shiftMF(*Bfield_cp[lev][dim], geom[lev-1], num_shift_crse, dir);
-                shiftMF(*Efield_cp[lev][dim], geom[lev-1], num_shift_crse, dir);
-                shiftMF(*Bfield_aux[lev][dim], geom[lev], num_shift, dir);
-                shiftMF(*Efield_aux[lev][dim], geom[lev], num_shift, dir);
+            const bool has_pml = do_pml && pml[lev]->ok();
+
+            // Fine grid
+            Vector<MultiFab*> mf_fp;
+            for (int dim = 0; dim < 3; ++dim) {
+                mf_fp.push_back(Bfield_fp[lev][dim].get());
+                mf_fp.push_back(Efield_fp[lev][dim].get());
                 if (move_j) {
-                    shiftMF(*current_cp[lev][dim], geom[lev-1], num_shift_crse, dir);
+                    mf_fp.push_back(current_fp[lev][dim].get());
                 }
-                if (do_pml && pml[lev]->ok()) {
-                    const std::array<MultiFab*, 3>& pml_B = pml[lev]->GetB_cp();
-                    const std::array<MultiFab*, 3>& pml_E = pml[lev]->GetE_cp();
-                    shiftMF(*pml_B[dim], geom[lev-1], num_shift_crse, dir);
-                    shiftMF(*pml_E[dim], geom[lev-1], num_shift_crse, dir);
+                if (has_pml) {
+                    mf_fp.push_back(pml[lev]->GetB_fp()[dim]);
+                    mf_fp.push_back(pml[lev]->GetE_fp()[dim]);
+                }
+                if (lev > 0) {
+                    mf_fp.push_back(Bfield_aux[lev][dim].get());
+                    mf_fp.push_back(Efield_aux[lev][dim].get());
                 }
             }
-        }
-
-        // Shift scalar component F for dive cleaning
-        if (do_dive_cleaning) {
-            // Fine grid
-            shiftMF(*F_fp[lev],   geom[lev], num_shift, dir);
-            if (do_pml && pml[lev]->ok()) {
-                MultiFab* pml_F = pml[lev]->GetF_fp();
-                shiftMF(*pml_F, geom[lev], num_shift, dir);
-            }
-            if (lev > 0) {
-                // Coarse grid
-                shiftMF(*F_cp[lev], geom[lev-1], num_shift_crse, dir);
-                if (do_pml && pml[lev]->ok()) {
-                    MultiFab* pml_F = pml[lev]->GetF_cp();
-                    shiftMF(*pml_F, geom[lev-1], num_shift_crse, dir);
+            // Scalar component F for dive cleaning, and rho
+            if (do_dive_cleaning) {
+                mf_fp.push_back(F_fp[lev].get());
+                if (has_pml) {
+                    mf_fp.push_back(pml[lev]->GetF_fp());
                 }
-                shiftMF(*rho_cp[lev], geom[lev-1], num_shift_crse, dir);
             }
-        }
+            if (move_j && rho_fp[lev]) {
+                mf_fp.push_back(rho_fp[lev].get());
+            }
+            shiftMF(mf_fp, geom[lev], num_shift, dir);
 
-        // Shift scalar component rho
-        if (move_j) {
-            if (rho_fp[lev]){
-                // Fine grid
-                shiftMF(*rho_fp[lev],   geom[lev], num_shift, dir);
-                if (lev > 0){
-                    // Coarse grid
-                    shiftMF(*rho_cp[lev], geom[lev-1], num_shift_crse, dir);
+            // Coarse grid
+            if (lev > 0) {
+                Vector<MultiFab*> mf_cp;
+                for (int dim = 0; dim < 3; ++dim) {
+                    mf_cp.push_back(Bfield_cp[lev][dim].get());
+                    mf_cp.push_back(Efield_cp[lev][dim].get());
+                    if (move_j) {
+                        mf_cp.push_back(current_cp[lev][dim].get());
+                    }
+                    if (has_pml) {
+                        mf_cp.push_back(pml[lev]->GetB_cp()[dim]);
+                        mf_cp.push_back(pml[lev]->GetE_cp()[dim]);
+                    }
+                }
+                if (do_dive_cleaning) {
+                    mf_cp.push_back(F_cp[lev].get());
+                    if (has_pml) {
+                        mf_cp.push_back(pml[lev]->GetF_cp());
+                    }
                 }
+                if ((do_dive_cleaning || move_j) && rho_cp[lev]) {
+                    mf_cp.push_back(rho_cp[lev].get());
+                }
+                shiftMF(mf_cp, geom[lev-1], num_shift_crse, dir);
             }
         }
     }
@@ -178,74 +218,157 @@ WarpX::MoveWindow (bool move_j)
     return num_shift_base;
 }
 
+/* \brief Returns a MultiFab with the same layout as mf, for shiftMF to copy
+ *  mf into. It is allocated at the first shift and reused afterwards, for
+ *  all the MultiFabs with this layout (shift_staging is cleared when the
+ *  grids change).
+ */
+MultiFab&
+WarpX::getShiftStaging (const MultiFab& mf)
+{
+    for (auto& tmp : shift_staging) {
+        if (tmp->boxArray() == mf.boxArray() &&
+            tmp->DistributionMap() == mf.DistributionMap() &&
+            tmp->nComp() == mf.nComp() && tmp->nGrowVect() == mf.nGrowVect())
+        {
+            return *tmp;
+        }
+    }
+    shift_staging.emplace_back(new MultiFab(mf.boxArray(), mf.DistributionMap(),
+                                            mf.nComp(), mf.nGrowVect(),
+                                            MFInfo().SetDeviceFab(false)));
+    return *shift_staging.back();
+}
+
+/* \brief Shifts the MultiFabs mf (defined on geom) by num_shift cells along
+ *  dir, in place, and sets to 0 the cells that enter the domain.
+ *
+ *  The valid cells of each box receive the values of the cells num_shift
+ *  cells further along dir: only the slab of guard cells on this side of
+ *  the box is exchanged beforehand (for all the MultiFabs at once). The
+ *  other guard cells are shifted but not updated; they are filled again
+ *  (e.g. by FillBoundaryEB, which MoveWindow triggers with
+ *  MarkFieldsModified) before they are used.
+ *  The data of each box is then moved with memmove, since the cells that
+ *  are contiguous in memory along the dimensions up to dir are shifted by
+ *  the same offset. On GPU, where the data is on the device, it is instead
+ *  shifted by a kernel that reads a copy of each MultiFab (in a staging
+ *  MultiFab that is kept for the next shifts, see getShiftStaging).
+ */
 void
-WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir)
+WarpX::shiftMF (const Vector<MultiFab*>& mf, const Geometry& geom, int num_shift, int dir)
 {
     BL_PROFILE("WarpX::shiftMF()");
-    const BoxArray& ba = mf.boxArray();
-    const DistributionMapping& dm = mf.DistributionMap();
-    const int nc = mf.nComp();
-    const IntVect& ng = mf.nGrowVect();
-
-    AMREX_ALWAYS_ASSERT(ng.min() >= num_shift);
-
-    MultiFab tmpmf(ba, dm, nc, ng, MFInfo().SetDeviceFab(false));
-    MultiFab::Copy(tmpmf, mf, 0, 0, nc, ng);
-    tmpmf.FillBoundary(geom.periodicity());
 
-    // Make a box that covers the region that the window moved into
-    const IndexType& typ = ba.ixType();
-    const Box& domainBox = geom.Domain();
-    Box adjBox;
+    IntVect nglo(0), nghi(0);
     if (num_shift > 0) {
-        adjBox = adjCellHi(domainBox, dir, ng[dir]);
+        nghi[dir] = num_shift;
     } else {
-        adjBox = adjCellLo(domainBox, dir, ng[dir]);
+        nglo[dir] = -num_shift;
     }
-    adjBox = amrex::convert(adjBox, typ);
+    guard_cell_exchange.FillBoundary(mf, geom.periodicity(), nglo, nghi);
 
-    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-        if (idim == dir and typ.nodeCentered(dir)) {
-            if (num_shift > 0) {
-                adjBox.growLo(idim, -1);
-            } else {
-                adjBox.growHi(idim, -1);
+    const int abs_shift = std::abs(num_shift);
+
+    for (MultiFab* pmf : mf)
+    {
+        const BoxArray& ba = pmf->boxArray();
+        const int nc = pmf->nComp();
+        const IntVect& ng = pmf->nGrowVect();
+
+        AMREX_ALWAYS_ASSERT(ng[dir] >= abs_shift);
+
+        // Make a box that covers the region that the window moved into
+        const IndexType& typ = ba.ixType();
+        const Box& domainBox = geom.Domain();
+        Box adjBox;
+        if (num_shift > 0) {
+            adjBox = adjCellHi(domainBox, dir, ng[dir]);
+        } else {
+            adjBox = adjCellLo(domainBox, dir, ng[dir]);
+        }
+        adjBox = amrex::convert(adjBox, typ);
+
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (idim == dir and typ.nodeCentered(dir)) {
+                if (num_shift > 0) {
+                    adjBox.growLo(idim, -1);
+                } else {
+                    adjBox.growHi(idim, -1);
+                }
+            } else if (idim != dir) {
+                adjBox.growLo(idim, ng[idim]);
+                adjBox.growHi(idim, ng[idim]);
             }
-        } else if (idim != dir) {
-            adjBox.growLo(idim, ng[idim]);
-            adjBox.growHi(idim, ng[idim]);
         }
-    }
 
-    IntVect shiftiv(0);
-    shiftiv[dir] = num_shift;
-    Dim3 shift = shiftiv.dim3();
+#ifdef AMREX_USE_GPU
+        // The data is on the device: shift it with a kernel, from a copy
+        MultiFab& tmpmf = getShiftStaging(*pmf);
+        MultiFab::Copy(tmpmf, *pmf, 0, 0, nc, ng);
 
-#ifdef _OPENMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-    for (MFIter mfi(tmpmf); mfi.isValid(); ++mfi )
-    {
-        auto const& dstfab = mf.array(mfi);
-        auto const& srcfab = tmpmf.array(mfi);
+        IntVect shiftiv(0);
+        shiftiv[dir] = num_shift;
+        Dim3 shift = shiftiv.dim3();
 
-        const Box& outbox = mfi.fabbox() & adjBox;
-        if (outbox.ok()) {
-            AMREX_PARALLEL_FOR_4D ( outbox, nc, i, j, k, n,
+        for (MFIter mfi(tmpmf); mfi.isValid(); ++mfi )
+        {
+            auto const& dstfab = pmf->array(mfi);
+            auto const& srcfab = tmpmf.array(mfi);
+
+            const Box& outbox = mfi.fabbox() & adjBox;
+            if (outbox.ok()) {
+                AMREX_PARALLEL_FOR_4D ( outbox, nc, i, j, k, n,
+                {
+                    srcfab(i,j,k,n) = 0.0;
+                });
+            }
+
+            Box dstBox = (*pmf)[mfi].box();
+            if (num_shift > 0) {
+                dstBox.growHi(dir, -num_shift);
+            } else {
+                dstBox.growLo(dir,  num_shift);
+            }
+            AMREX_PARALLEL_FOR_4D ( dstBox, nc, i, j, k, n,
             {
-                srcfab(i,j,k,n) = 0.0;
+                dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
             });
         }
+#else
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(*pmf); mfi.isValid(); ++mfi )
+        {
+            FArrayBox& fab = (*pmf)[mfi];
 
-        Box dstBox = mf[mfi].box();
-        if (num_shift > 0) {
-            dstBox.growHi(dir, -num_shift);
-        } else {
-            dstBox.growLo(dir,  num_shift);
+            const Box& outbox = mfi.fabbox() & adjBox;
+            if (outbox.ok()) {
+                fab.setVal(0.0, outbox, 0, nc);
+            }
+
+            // Cells of the dimensions up to dir are contiguous, and are
+            // shifted by num_shift*stride
+            const IntVect& len = fab.box().length();
+            long stride = 1;
+            for (int idim = 0; idim < dir; ++idim) stride *= len[idim];
+            long nouter = 1;
+            for (int idim = dir+1; idim < AMREX_SPACEDIM; ++idim) nouter *= len[idim];
+            const long chunk = stride*len[dir];
+            const long nmove = stride*(len[dir] - abs_shift);
+            for (int n = 0; n < nc; ++n) {
+                Real* p = fab.dataPtr(n);
+                for (long o = 0; o < nouter; ++o) {
+                    Real* row = p + o*chunk;
+                    if (num_shift > 0) {
+                        std::memmove(row, row + abs_shift*stride, nmove*sizeof(Real));
+                    } else {
+                        std::memmove(row + abs_shift*stride, row, nmove*sizeof(Real));
+                    }
+                }
+            }
         }
-        AMREX_PARALLEL_FOR_4D ( dstBox, nc, i, j, k, n,
-        {
-            dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
-        });
+#endif
     }
 }
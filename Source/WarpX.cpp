@@ -17,6 +17,7 @@
 #include <WarpXConst.H>
 #include <WarpXWrappers.h>
 #include <WarpXUtil.H>
+#include <ScratchArena.H>
 
 #ifdef BL_USE_SENSEI_INSITU
 #include <AMReX_AmrMeshInSituBridge.H>
@@ -26,6 +27,8 @@ using namespace amrex;
 
 Vector<Real> WarpX::B_external(3, 0.0);
 
+Vector<Real> WarpX::v_galilean(3, 0.0);
+
 int WarpX::do_moving_window = 0;
 int WarpX::moving_window_dir = -1;
 
@@ -38,12 +41,17 @@ long WarpX::charge_deposition_algo = 0;
 long WarpX::field_gathering_algo = 1;
 long WarpX::particle_pusher_algo = 0;
 int WarpX::maxwell_fdtd_solver_id = 0;
+int WarpX::fused_particle_loop = 0;
+int WarpX::use_picsar_deposition = 0;
+int WarpX::use_picsar_gather = 0;
+int WarpX::fdtd_temporal_blocking = 0;
 
 long WarpX::nox = 1;
 long WarpX::noy = 1;
 long WarpX::noz = 1;
 
 bool WarpX::use_fdtd_nci_corr = false;
+bool WarpX::nci_corr_filter_on_level = false;
 int  WarpX::l_lower_order_in_v = true;
 
 bool WarpX::use_filter        = false;
@@ -51,6 +59,8 @@ bool WarpX::serialize_ics     = false;
 bool WarpX::refine_plasma     = false;
 
 int  WarpX::sort_int = -1;
+int  WarpX::sort_on_redistribute = 0;
+int  WarpX::overlap_field_comm = 0;
 
 bool WarpX::do_boosted_frame_diagnostic = false;
 int  WarpX::num_snapshots_lab = std::numeric_limits<int>::lowest();
@@ -58,6 +68,10 @@ Real WarpX::dt_snapshots_lab  = std::numeric_limits<Real>::lowest();
 bool WarpX::do_boosted_frame_fields = true;
 bool WarpX::do_boosted_frame_particles = true;
 
+#ifdef WARPX_LEAN_PARTICLES
+int WarpX::plot_particle_fields = 0;
+#endif
+
 bool WarpX::do_dynamic_scheduling = true;
 
 #if (AMREX_SPACEDIM == 3)
@@ -121,6 +135,8 @@ WarpX::WarpX ()
 
     ReadParameters();
 
+    ScratchArena::Initialize();
+
     // Geometry on all levels has been defined already.
 
     // No valid BoxArray and DistributionMapping have been defined.
@@ -130,12 +146,11 @@ WarpX::WarpX ()
 
     istep.resize(nlevs_max, 0);
     nsubsteps.resize(nlevs_max, 1);
-#if 0
-    // no subcycling yet
-    for (int lev = 1; lev <= maxLevel(); ++lev) {
-	nsubsteps[lev] = MaxRefRatio(lev-1);
+    if (do_subcycling == 1) {
+        for (int lev = 1; lev <= maxLevel(); ++lev) {
+            nsubsteps[lev] = MaxRefRatio(lev-1);
+        }
     }
-#endif
 
     t_new.resize(nlevs_max, 0.0);
     t_old.resize(nlevs_max, -1.e100);
@@ -163,6 +178,8 @@ WarpX::WarpX ()
     Bfield_fp.resize(nlevs_max);
 
     current_store.resize(nlevs_max);
+    Bfield_sub_start.resize(nlevs_max);
+    Bfield_sub_half.resize(nlevs_max);
 
     F_cp.resize(nlevs_max);
     rho_cp.resize(nlevs_max);
@@ -172,6 +189,8 @@ WarpX::WarpX ()
 
     Efield_cax.resize(nlevs_max);
     Bfield_cax.resize(nlevs_max);
+    Efield_aux_crse.resize(nlevs_max);
+    Bfield_aux_crse.resize(nlevs_max);
     current_buffer_masks.resize(nlevs_max);
     gather_buffer_masks.resize(nlevs_max);
     current_buf.resize(nlevs_max);
@@ -184,6 +203,10 @@ WarpX::WarpX ()
 
     pml.resize(nlevs_max);
 
+    field_version.resize(nlevs_max, 0);
+    guards_filled_version.resize(nlevs_max, -1);
+    aux_version.resize(nlevs_max);
+
 #ifdef WARPX_DO_ELECTROSTATIC
     masks.resize(nlevs_max);
     gather_masks.resize(nlevs_max);
@@ -233,6 +256,8 @@ WarpX::~WarpX ()
 #ifdef BL_USE_SENSEI_INSITU
     delete insitu_bridge;
 #endif
+
+    ScratchArena::Finalize();
 }
 
 void
@@ -264,8 +289,16 @@ WarpX::ReadParameters ()
 	pp.query("regrid_int", regrid_int);
     pp.query("do_subcycling", do_subcycling);
 
-    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(do_subcycling != 1 || max_level <= 1,
-                                     "Subcycling method 1 only works for 2 levels.");
+    if (do_subcycling == 1) {
+#ifdef WARPX_USE_PSATD
+        amrex::Abort("warpx.do_subcycling is not implemented with PSATD");
+#endif
+        for (int lev = 0; lev < max_level; ++lev) {
+            const IntVect& rr = refRatio(lev);
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(rr.min() == rr.max() && (rr[0] == 2 || rr[0] == 4),
+                "Subcycling method 1 only works with a refinement ratio of 2 or 4, the same in all directions.");
+        }
+    }
 
     ReadBoostedFrameParameters(gamma_boost, beta_boost, boost_direction);
 
@@ -361,6 +394,8 @@ WarpX::ReadParameters ()
         pp.query("n_field_gather_buffer", n_field_gather_buffer);
         pp.query("n_current_deposition_buffer", n_current_deposition_buffer);
 	pp.query("sort_int", sort_int);
+        pp.query("sort_on_redistribute", sort_on_redistribute);
+        pp.query("overlap_field_comm", overlap_field_comm);
 
         pp.query("do_pml", do_pml);
         pp.query("pml_ncell", pml_ncell);
@@ -434,30 +469,43 @@ WarpX::ReadParameters ()
         {
             pp.queryarr("particle_plot_vars", particle_plot_vars);
 
-            if (particle_plot_vars.size() == 0)
+            int nplot_comps = PIdx::nattribs;
+            if (WarpX::do_boosted_frame_diagnostic && WarpX::do_boosted_frame_particles)
             {
-                if (WarpX::do_boosted_frame_diagnostic && WarpX::do_boosted_frame_particles)
-                {
-                    particle_plot_flags.resize(PIdx::nattribs + 6, 1);
+                nplot_comps += 6;
+            }
+
+#ifdef WARPX_LEAN_PARTICLES
+            // The gathered fields are stored after all the other components,
+            // and only if they are explicitly requested
+            const auto& field_names = ParticleStringNames::field_names;
+            const int field_comps_start = nplot_comps;
+            for (const auto& var : particle_plot_vars)
+            {
+                if (std::find(field_names.begin(), field_names.end(), var) != field_names.end()) {
+                    plot_particle_fields = 1;
                 }
-                else
-                {
-                    particle_plot_flags.resize(PIdx::nattribs, 1);
-                }                
+            }
+            if (plot_particle_fields) nplot_comps += GatheredFieldIdx::nfields;
+#endif
+
+            if (particle_plot_vars.size() == 0)
+            {
+                particle_plot_flags.resize(nplot_comps, 1);
             }
             else
             {
-                if (WarpX::do_boosted_frame_diagnostic && WarpX::do_boosted_frame_particles)
-                {
-                    particle_plot_flags.resize(PIdx::nattribs + 6, 0);
-                }
-                else
-                {
-                    particle_plot_flags.resize(PIdx::nattribs, 0);
-                }                
+                particle_plot_flags.resize(nplot_comps, 0);
 
                 for (const auto& var : particle_plot_vars)
                 {
+#ifdef WARPX_LEAN_PARTICLES
+                    auto it = std::find(field_names.begin(), field_names.end(), var);
+                    if (it != field_names.end()) {
+                        particle_plot_flags[field_comps_start + (it - field_names.begin())] = 1;
+                        continue;
+                    }
+#endif
                     particle_plot_flags[ParticleStringNames::to_index.at(var)] = 1;
                 }
             }
@@ -466,6 +514,22 @@ WarpX::ReadParameters ()
         pp.query("load_balance_int", load_balance_int);
         pp.query("load_balance_with_sfc", load_balance_with_sfc);
         pp.query("load_balance_knapsack_factor", load_balance_knapsack_factor);
+        pp.query("load_balance_with_hysteresis", load_balance_with_hysteresis);
+        pp.query("load_balance_injection", load_balance_injection);
+        pp.query("load_balance_injection_threshold", load_balance_injection_threshold);
+        {
+            std::string s_costs_type = "timers";
+            pp.query("load_balance_costs_type", s_costs_type);
+            std::transform(s_costs_type.begin(), s_costs_type.end(),
+                           s_costs_type.begin(), ::tolower);
+            if (s_costs_type == "timers") {
+                load_balance_costs_type = LoadBalanceCostsType::Timers;
+            } else if (s_costs_type == "heuristic") {
+                load_balance_costs_type = LoadBalanceCostsType::Heuristic;
+            } else {
+                amrex::Abort("Unknown load balance costs type " + s_costs_type);
+            }
+        }
 
         pp.query("do_dynamic_scheduling", do_dynamic_scheduling);
 
@@ -501,6 +565,13 @@ WarpX::ReadParameters ()
 	pp.query("charge_deposition", charge_deposition_algo);
 	pp.query("field_gathering", field_gathering_algo);
 	pp.query("particle_pusher", particle_pusher_algo);
+	pp.query("fused_particle_loop", fused_particle_loop);
+        pp.query("use_picsar_deposition", use_picsar_deposition);
+        pp.query("use_picsar_gather", use_picsar_gather);
+#ifdef WARPX_RZ
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(fused_particle_loop == 0,
+            "algo.fused_particle_loop is not implemented in RZ geometry");
+#endif
 	std::string s_solver = "";
 	pp.query("maxwell_fdtd_solver", s_solver);
         std::transform(s_solver.begin(),
@@ -515,10 +586,36 @@ WarpX::ReadParameters ()
                 maxwell_fdtd_solver_id = 0;
             } else if (s_solver == "ckc") {
                 maxwell_fdtd_solver_id = 1;
+            } else if (s_solver == "fourth_order") {
+                maxwell_fdtd_solver_id = 2;
             } else {
                 amrex::Abort("Unknown FDTD Solver type " + s_solver);
             }
         }
+#ifdef WARPX_RZ
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(maxwell_fdtd_solver_id == 0,
+            "Only the Yee solver is implemented with cylindrical geometry");
+#endif
+        if (maxwell_fdtd_solver_id == 2) {
+            // The coefficients of the NCI corrector are computed for the
+            // dispersion of the Yee and CKC solvers only
+            bool nci_corr = false;
+            ParmParse ppp("particles");
+            ppp.query("use_fdtd_nci_corr", nci_corr);
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!nci_corr,
+                "particles.use_fdtd_nci_corr does not work with algo.maxwell_fdtd_solver = fourth_order");
+        }
+
+        pp.query("fdtd_temporal_blocking", fdtd_temporal_blocking);
+        if (fdtd_temporal_blocking) {
+#if defined(WARPX_USE_PSATD) || defined(WARPX_RZ) || defined(AMREX_USE_GPU)
+            amrex::Abort("algo.fdtd_temporal_blocking is not implemented with PSATD, RZ or GPU");
+#endif
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(maxwell_fdtd_solver_id == 0 || do_nodal,
+                "algo.fdtd_temporal_blocking only works with the Yee or nodal solver");
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!do_pml && !do_dive_cleaning,
+                "algo.fdtd_temporal_blocking does not work with PML or divergence cleaning");
+        }
     }
 
 #ifdef WARPX_USE_PSATD
@@ -527,9 +624,40 @@ WarpX::ReadParameters ()
         pp.query("hybrid_mpi_decomposition", fft_hybrid_mpi_decomposition);
         pp.query("ngroups_fft", ngroups_fft);
         pp.query("fftw_plan_measure", fftw_plan_measure);
+        pp.query("fftw_nthreads", fftw_nthreads);
+        pp.query("fftw_wisdom_file", fftw_wisdom_file);
+        {
+            std::string s_coef_storage = "full";
+            pp.query("coefficients_storage", s_coef_storage);
+            std::transform(s_coef_storage.begin(), s_coef_storage.end(),
+                           s_coef_storage.begin(), ::tolower);
+            if (s_coef_storage == "full") {
+                psatd_coefficients_storage = PsatdCoefficientsStorage::Full;
+            } else if (s_coef_storage == "octant") {
+                psatd_coefficients_storage = PsatdCoefficientsStorage::Octant;
+            } else if (s_coef_storage == "on_the_fly") {
+                psatd_coefficients_storage = PsatdCoefficientsStorage::OnTheFly;
+            } else {
+                amrex::Abort("Unknown psatd.coefficients_storage " + s_coef_storage);
+            }
+        }
         pp.query("nox", nox_fft);
         pp.query("noy", noy_fft);
         pp.query("noz", noz_fft);
+        // Velocity of the Galilean grid, given in units of c
+        pp.queryarr("v_galilean", v_galilean);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(v_galilean.size() == 3,
+            "psatd.v_galilean must have 3 components");
+        for (auto& v : v_galilean) v *= PhysConst::c;
+        if (v_galilean[0] != 0. || v_galilean[1] != 0. || v_galilean[2] != 0.) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!fft_hybrid_mpi_decomposition,
+                "psatd.v_galilean is not implemented with psatd.hybrid_mpi_decomposition");
+        }
+        // The refined patches have no PML with PSATD: the guard cells of
+        // their FFT boxes hold the fields of the parent level instead
+        // (see FillFFTGuardRing)
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(maxLevel() == 0 || !do_pml,
+            "PSATD with mesh refinement requires warpx.do_pml = 0");
         // Override value
         if (fft_hybrid_mpi_decomposition==false) ngroups_fft=ParallelDescriptor::NProcs();
     }
@@ -566,6 +694,10 @@ WarpX::MakeNewLevelFromScratch (int lev, Real time, const BoxArray& new_grids,
 void
 WarpX::ClearLevel (int lev)
 {
+    guard_cell_exchange.ClearCache();
+    shift_staging.clear();
+    MarkFieldsModified(lev);
+
     for (int i = 0; i < 3; ++i) {
 	Efield_aux[lev][i].reset();
 	Bfield_aux[lev][i].reset();
@@ -582,12 +714,19 @@ WarpX::ClearLevel (int lev)
 
 	Efield_cax[lev][i].reset();
 	Bfield_cax[lev][i].reset();
+	Efield_aux_crse[lev][i].reset();
+	Bfield_aux_crse[lev][i].reset();
         current_buf[lev][i].reset();
 
         current_fp_owner_masks[lev][i].reset();
         current_cp_owner_masks[lev][i].reset();
     }
 
+    for (int i = 0; i < 6; ++i) {
+        Bfield_sub_start[lev][i].reset();
+        Bfield_sub_half[lev][i].reset();
+    }
+
     rho_fp_owner_masks[lev].reset();
     rho_cp_owner_masks[lev].reset();
 
@@ -630,12 +769,13 @@ WarpX::ClearLevel (int lev)
 void
 WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& dm)
 {
-    // When using subcycling, the particles on the fine level perform two pushes
-    // before being redistributed ; therefore, we need one extra guard cell
-    // (the particles may move by 2*c*dt)
-    const int ngx_tmp = (maxLevel() > 0 && do_subcycling == 1) ? WarpX::nox+1 : WarpX::nox;
-    const int ngy_tmp = (maxLevel() > 0 && do_subcycling == 1) ? WarpX::noy+1 : WarpX::noy;
-    const int ngz_tmp = (maxLevel() > 0 && do_subcycling == 1) ? WarpX::noz+1 : WarpX::noz;
+    // When using subcycling, the particles on the finest level perform
+    // NumSubsteps(maxLevel()) pushes before being redistributed ; therefore,
+    // we need extra guard cells (the particles may move by NumSubsteps*c*dt)
+    const int ngsub = NumSubsteps(maxLevel()) - 1;
+    const int ngx_tmp = WarpX::nox + ngsub;
+    const int ngy_tmp = WarpX::noy + ngsub;
+    const int ngz_tmp = WarpX::noz + ngsub;
 
     // Ex, Ey, Ez, Bx, By, and Bz have the same number of ghost cells.
     // jx, jy, jz and rho have the same number of ghost cells.
@@ -672,6 +812,21 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
         ngJz = std::max(ngJz,2);
     }
 
+    // With temporal blocking, the first half push of B is done in 2 guard
+    // cells, which reads E in 3 guard cells (rounded up to an even number).
+    if (fdtd_temporal_blocking) {
+        ngx = std::max(ngx,4);
+        ngy = std::max(ngy,4);
+        ngz = std::max(ngz,4);
+    }
+
+    // The fourth-order solver reads E and B two cells away
+    if (maxwell_fdtd_solver_id == 2) {
+        ngx = std::max(ngx,2);
+        ngy = std::max(ngy,2);
+        ngz = std::max(ngz,2);
+    }
+
 #if (AMREX_SPACEDIM == 3)
     IntVect ngE(ngx,ngy,ngz);
     IntVect ngJ(ngJx,ngJy,ngJz);
@@ -694,6 +849,8 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
     int ngF = (do_moving_window) ? 2 : 0;
     // CKC solver requires one additional guard cell
     if (maxwell_fdtd_solver_id == 1) ngF = std::max( ngF, 1 );
+    // The fourth-order solver reaches two cells on each side
+    if (maxwell_fdtd_solver_id == 2) ngF = std::max( ngF, 2 );
 
     AllocLevelMFs(lev, ba, dm, ngE, ngJ, ngRho, ngF);
 }
@@ -728,7 +885,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         rho_fp_owner_masks[lev] = std::move(rho_fp[lev]->OwnerMask(period));
     }
 
-    if (do_subcycling == 1 && lev == 0)
+    if (do_subcycling == 1 && lev < maxLevel())
     {
         current_store[lev][0].reset( new MultiFab(amrex::convert(ba,jx_nodal_flag),dm,1,ngJ));
         current_store[lev][1].reset( new MultiFab(amrex::convert(ba,jy_nodal_flag),dm,1,ngJ));
@@ -832,8 +989,14 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
             Efield_cax[lev][1].reset( new MultiFab(amrex::convert(cba,Ey_nodal_flag),dm,1,ngE));
             Efield_cax[lev][2].reset( new MultiFab(amrex::convert(cba,Ez_nodal_flag),dm,1,ngE));
 
-            gather_buffer_masks[lev].reset( new iMultiFab(ba, dm, 1, 1) );
-            // Gather buffer masks have 1 ghost cell, because of the fact
+            // The cells that are not covered by the coarse aux keep this value
+            for (int idim = 0; idim < 3; ++idim) {
+                Bfield_cax[lev][idim]->setVal(0.0);
+                Efield_cax[lev][idim]->setVal(0.0);
+            }
+
+            gather_buffer_masks[lev].reset( new iMultiFab(ba, dm, 1, ngBufferMasks(lev)) );
+            // Gather buffer masks have ghost cells, because of the fact
             // that particles may move by more than one cell when using subcycling.
         }
 
@@ -844,12 +1007,26 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
             if (do_dive_cleaning || plot_rho) {
                 charge_buf[lev].reset( new MultiFab(amrex::convert(cba,IntVect::TheUnitVector()),dm,2,ngRho));
             }
-            current_buffer_masks[lev].reset( new iMultiFab(ba, dm, 1, 1) );
-            // Current buffer masks have 1 ghost cell, because of the fact
+            current_buffer_masks[lev].reset( new iMultiFab(ba, dm, 1, ngBufferMasks(lev)) );
+            // Current buffer masks have ghost cells, because of the fact
             // that particles may move by more than one cell when using subcycling.
         }
     }
 
+    if (lev > 0 && !Bfield_cax[lev][0])
+    {
+        for (int idim = 0; idim < 3; ++idim) {
+            const MultiFab& Bcp = *Bfield_cp[lev][idim];
+            const MultiFab& Ecp = *Efield_cp[lev][idim];
+            Bfield_aux_crse[lev][idim].reset( new MultiFab(Bcp.boxArray(),dm,1,ngE));
+            Efield_aux_crse[lev][idim].reset( new MultiFab(Ecp.boxArray(),dm,1,ngE));
+            Bfield_aux_crse[lev][idim]->setVal(0.0);
+            Efield_aux_crse[lev][idim]->setVal(0.0);
+        }
+    }
+
+    MarkFieldsModified(lev);
+
     if (load_balance_int > 0) {
         costs[lev].reset(new MultiFab(ba, dm, 1, 0));
     }
@@ -891,6 +1068,21 @@ WarpX::LowerCorner(const Box& bx, int lev)
 #endif
 }
 
+std::array<Real,3>
+WarpX::LowerCorner(const Box& bx, int lev, Real time_shift)
+{
+    std::array<Real,3> xyzmin = LowerCorner(bx, lev);
+    // The geometry corresponds to the beginning of the step (it is only
+    // updated at the end of the step, in ShiftGalileanGrid): add the
+    // displacement of the grid since then
+    xyzmin[0] += v_galilean[0]*time_shift;
+#if (AMREX_SPACEDIM == 3)
+    xyzmin[1] += v_galilean[1]*time_shift;
+#endif
+    xyzmin[2] += v_galilean[2]*time_shift;
+    return xyzmin;
+}
+
 std::array<Real,3>
 WarpX::UpperCorner(const Box& bx, int lev)
 {
@@ -1064,12 +1256,29 @@ WarpX::StoreCurrent (int lev)
     }
 }
 
+int
+WarpX::NumSubsteps (int lev) const
+{
+    int nsub = 1;
+    for (int ilev = 1; ilev <= lev; ++ilev) {
+        nsub *= nsubsteps[ilev];
+    }
+    return nsub;
+}
+
+int
+WarpX::ngBufferMasks (int lev) const
+{
+    return std::max(1, NumSubsteps(lev)-1);
+}
+
 void
 WarpX::RestoreCurrent (int lev)
 {
     for (int idim = 0; idim < 3; ++idim) {
         if (current_store[lev][idim]) {
-            std::swap(current_fp[lev][idim], current_store[lev][idim]);
+            MultiFab::Copy(*current_fp[lev][idim], *current_store[lev][idim],
+                           0, 0, 1, current_store[lev][idim]->nGrowVect());
         }
     }
 }
@@ -90,6 +90,7 @@ if args.automated == True:
     test_list.extend([['automated_test_4_labdiags_2ppc',      1, 16, 8]]*n_repeat)
     test_list.extend([['automated_test_5_loadimbalance',      1, 16, 8]]*n_repeat)
     test_list.extend([['automated_test_6_output_2ppc',        1, 16, 8]]*n_repeat)     
+    test_list.extend([['automated_test_7_uniform_rest_32ppc_picsar_deposition', 1, 16, 8]]*n_repeat)
     do_commit = False
     run_name = 'automated_tests'
 
@@ -322,7 +323,8 @@ if args.mode == 'read':
                      'automated_test_3_uniform_drift_4ppc',\
                      'automated_test_4_labdiags_2ppc',\
                      'automated_test_5_loadimbalance',\
-                     'automated_test_6_output_2ppc']
+                     'automated_test_6_output_2ppc',\
+                     'automated_test_7_uniform_rest_32ppc_picsar_deposition']
     selector_string = selector_list[0]
     selector = [idx for idx in range(len(namelist)) if selector_string in namelist[idx]]
     lin_date = date[:,0]+date[:,1]/12.+date[:,2]/366.
@@ -103,6 +103,12 @@ test_list_unq.append( test_element(input_file='automated_test_1_uniform_rest_32p
                                    n_omp=8, 
                                    n_cell=[128, 128, 128], 
                                    n_step=10) )
+# Same as automated_test_1, with the PICSAR current deposition instead of the C++ one
+test_list_unq.append( test_element(input_file='automated_test_7_uniform_rest_32ppc_picsar_deposition',
+                                   n_mpi_per_node=8,
+                                   n_omp=8,
+                                   n_cell=[128, 128, 128],
+                                   n_step=10) )
 test_list_unq.append( test_element(input_file='automated_test_2_uniform_rest_1ppc', 
                                    n_mpi_per_node=8, 
                                    n_omp=8, 